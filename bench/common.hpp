@@ -0,0 +1,129 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 07:42
+
+
+// Helpers for benchmarks: command line options (see options.hpp), async_core policies and latency percentiles.
+
+
+#ifndef DKUK_BENCH_COMMON_HPP
+#define DKUK_BENCH_COMMON_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <dkuk/async_core.hpp>
+
+#include "options.hpp"
+
+
+namespace dkuk {
+namespace bench {
+
+
+inline
+async_core::worker::poll
+parse_poll_policy(
+	const std::string &value
+)
+{
+	if (value == "disabled") return async_core::worker::poll::disabled;
+	if (value == "poll_one") return async_core::worker::poll::poll_one;
+	if (value == "poll_all") return async_core::worker::poll::poll_all;
+	if (value == "run_one")  return async_core::worker::poll::run_one;
+	throw std::invalid_argument{"Unknown poll policy: " + value};
+}
+
+
+inline
+async_core::worker::delay
+parse_delay_policy(
+	const std::string &value
+)
+{
+	if (value == "no_delay") return async_core::worker::delay::no_delay;
+	if (value == "yield")    return async_core::worker::delay::yield;
+	if (value == "sleep")    return async_core::worker::delay::sleep;
+	throw std::invalid_argument{"Unknown delay policy: " + value};
+}
+
+
+
+// Latency samples. Not thread-safe: use one recorder per thread (or coroutine) and merge them.
+class latency_recorder
+{
+public:
+	inline
+	void
+	add(
+		std::chrono::nanoseconds latency
+	)
+	{
+		this->samples_.push_back(latency.count());
+		this->sorted_ = false;
+	}
+	
+	
+	inline
+	void
+	merge(
+		const latency_recorder &other
+	)
+	{
+		this->samples_.insert(this->samples_.end(), other.samples_.begin(), other.samples_.end());
+		this->sorted_ = false;
+	}
+	
+	
+	inline
+	std::size_t
+	size() const noexcept
+	{
+		return this->samples_.size();
+	}
+	
+	
+	// Quantile in [0, 1]: 0.5 for median, 0.99 for p99, etc.
+	std::chrono::nanoseconds
+	percentile(
+		double quantile
+	)
+	{
+		if (this->samples_.empty())
+			return std::chrono::nanoseconds::zero();
+		
+		if (!this->sorted_) {
+			std::sort(this->samples_.begin(), this->samples_.end());
+			this->sorted_ = true;
+		}
+		
+		const std::size_t index = std::min(
+			static_cast<std::size_t>(quantile * this->samples_.size()),
+			this->samples_.size() - 1
+		);
+		return std::chrono::nanoseconds{this->samples_[index]};
+	}
+private:
+	std::vector<std::chrono::nanoseconds::rep> samples_;
+	bool sorted_ = true;
+};	// class latency_recorder
+
+
+
+template<class Duration>
+inline
+double
+to_microseconds(
+	Duration duration
+)
+{
+	return std::chrono::duration<double, std::micro>{duration}.count();
+}
+
+
+};	// namespace bench
+};	// namespace dkuk
+
+
+#endif	// DKUK_BENCH_COMMON_HPP
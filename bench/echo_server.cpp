@@ -0,0 +1,245 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 07:42
+
+
+// Loopback echo benchmark: TCP echo server over localhost, where each connection is a coroutine (dkuk::spawn)
+// running in async_core context, and built-in client load generator (own io_context and threads).
+//
+// Server topology:
+// - root context with --workers workers, acceptor runs there;
+// - --children child contexts with --child-workers workers each. Connections are distributed between children
+//   round-robin (or handled by the root, if there are no children). Root workers poll children according to
+//   --poll and --delay policies (worker without children just runs its io_context).
+//
+// Each client connection sends --message-size bytes and waits for the echo (one request), until --duration seconds
+// are elapsed. Output: requests/sec and p50/p99/p999 latency of requests.
+
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+
+#include <dkuk/async_core.hpp>
+#include <dkuk/coroutine.hpp>
+
+#include "common.hpp"
+
+
+namespace {
+
+
+const char usage[] =
+	"Usage: echo_server [options]\n"
+	"  --connections N      client connections (default: 64)\n"
+	"  --duration S         seconds of load (default: 5)\n"
+	"  --message-size B     request size in bytes (default: 64)\n"
+	"  --workers N          workers of the root context (default: 2)\n"
+	"  --children N         child contexts, which handle connections (default: 0)\n"
+	"  --child-workers N    workers of each child context (default: 1)\n"
+	"  --self-poll P        root workers' self poll policy: poll_one|poll_all|run_one (default: poll_all)\n"
+	"  --poll P             root workers' children poll policy: poll_one|poll_all|run_one (default: poll_one)\n"
+	"  --delay D            root workers' delay policy: no_delay|yield|sleep (default: yield)\n"
+	"  --delay-us N         delay for sleep policy in microseconds (default: 100)\n"
+	"  --client-threads N   threads of the load generator (default: 2)";
+
+
+
+struct server_state
+{
+	std::atomic<std::size_t> connections_count{0};	// Active connections
+	std::size_t buffer_size;
+};	// struct server_state
+
+
+
+void
+serve_connection(
+	server_state &state,
+	boost::asio::ip::tcp::socket socket,
+	dkuk::coroutine_context context
+)
+{
+	const dkuk::pooled_buffer buffer = context.acquire_buffer(state.buffer_size);
+	boost::system::error_code ec;
+	while (true) {
+		const std::size_t bytes_transferred = socket.async_read_some(buffer.buffer(), context[ec]);
+		if (ec)
+			break;
+		
+		boost::asio::async_write(socket, buffer.buffer(bytes_transferred), context[ec]);
+		if (ec)
+			break;
+	}
+	--state.connections_count;
+}
+
+
+void
+accept_connections(
+	dkuk::async_core &core,
+	const std::vector<dkuk::async_core::context_id_type> &connection_contexts,
+	boost::asio::ip::tcp::acceptor &acceptor,
+	server_state &state,
+	dkuk::coroutine_context context
+)
+{
+	boost::system::error_code ec;
+	for (std::size_t i = 0; ; ++i) {
+		boost::asio::io_context &io_context = core.get_io_context(connection_contexts[i % connection_contexts.size()]);
+		boost::asio::ip::tcp::socket socket{io_context};
+		acceptor.async_accept(socket, context[ec]);
+		if (ec)	// Acceptor is closed
+			return;
+		
+		socket.set_option(boost::asio::ip::tcp::no_delay{true});
+		++state.connections_count;
+		dkuk::spawn(io_context, serve_connection, std::ref(state), std::move(socket));
+	}
+}
+
+
+void
+run_client(
+	const boost::asio::ip::tcp::endpoint &endpoint,
+	std::size_t message_size,
+	std::chrono::steady_clock::time_point deadline,
+	dkuk::bench::latency_recorder &recorder,
+	dkuk::coroutine_context context
+)
+{
+	boost::asio::ip::tcp::socket socket{context.get_executor().context()};
+	socket.async_connect(endpoint, context);
+	socket.set_option(boost::asio::ip::tcp::no_delay{true});
+	
+	const std::string request(message_size, 'x');
+	std::string response(message_size, '\0');
+	while (std::chrono::steady_clock::now() < deadline) {
+		const auto start = std::chrono::steady_clock::now();
+		boost::asio::async_write(socket, boost::asio::buffer(request), context);
+		boost::asio::async_read(socket, boost::asio::buffer(&response[0], response.size()), context);
+		recorder.add(std::chrono::steady_clock::now() - start);
+	}
+}
+
+
+};	// namespace
+
+
+
+int
+main(
+	int argc,
+	char **argv
+)
+{
+	try {
+		dkuk::bench::options options{argc, argv, usage};
+		const std::size_t connections_count    = options.get_size("connections", 64);
+		const double      duration             = options.get_double("duration", 5);
+		const std::size_t message_size         = options.get_size("message-size", 64);
+		const std::size_t workers_count        = options.get_size("workers", 2);
+		const std::size_t children_count       = options.get_size("children", 0);
+		const std::size_t child_workers_count  = options.get_size("child-workers", 1);
+		const std::string self_poll_policy     = options.get_string("self-poll", "poll_all");
+		const std::string children_poll_policy = options.get_string("poll", "poll_one");
+		const std::string delay_policy         = options.get_string("delay", "yield");
+		const std::size_t delay_us             = options.get_size("delay-us", 100);
+		const std::size_t client_threads_count = options.get_size("client-threads", 2);
+		options.check_unknown();
+		
+		if (connections_count == 0 || message_size == 0 || client_threads_count == 0)
+			throw std::invalid_argument{"Connections, message size and client threads should be positive"};
+		
+		// Server
+		dkuk::async_core::worker::parameters root_worker_parameters;
+		root_worker_parameters.self_poll_policy     = dkuk::bench::parse_poll_policy(self_poll_policy);
+		root_worker_parameters.children_poll_policy = dkuk::bench::parse_poll_policy(children_poll_policy);
+		root_worker_parameters.delay_policy         = dkuk::bench::parse_delay_policy(delay_policy);
+		root_worker_parameters.delay_value          = std::chrono::microseconds{delay_us};
+		
+		dkuk::async_core::context_tree t;
+		const auto root = t.add_context(0, 0);
+		for (std::size_t i = 0; i < workers_count; ++i)
+			t.add_worker(root, root_worker_parameters);
+		
+		std::vector<dkuk::async_core::context_id_type> connection_contexts;
+		for (std::size_t i = 0; i < children_count; ++i)
+			connection_contexts.push_back(t.add_context(root, child_workers_count));
+		if (connection_contexts.empty())
+			connection_contexts.push_back(root);
+		
+		server_state state;
+		state.buffer_size = message_size;
+		
+		dkuk::async_core core{t};
+		boost::asio::ip::tcp::acceptor acceptor{
+			core.get_io_context(root),
+			boost::asio::ip::tcp::endpoint{boost::asio::ip::address_v4::loopback(), 0}
+		};
+		const boost::asio::ip::tcp::endpoint endpoint = acceptor.local_endpoint();
+		dkuk::spawn(
+			core.get_io_context(root),
+			accept_connections,
+			std::ref(core), std::cref(connection_contexts), std::ref(acceptor), std::ref(state)
+		);
+		
+		// Load generator
+		boost::asio::io_context client_io_context;
+		std::vector<dkuk::bench::latency_recorder> recorders(connections_count);
+		const auto start = std::chrono::steady_clock::now();
+		const auto deadline =
+			start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+				std::chrono::duration<double>{duration}
+			);
+		for (auto &recorder: recorders)
+			dkuk::spawn(client_io_context, run_client, endpoint, message_size, deadline, std::ref(recorder));
+		
+		std::vector<std::thread> client_threads;
+		for (std::size_t i = 0; i < client_threads_count; ++i)
+			client_threads.emplace_back([&client_io_context] { client_io_context.run(); });
+		for (auto &thread: client_threads)
+			thread.join();
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+		
+		// Shutdown: server coroutines finish, when clients disconnect
+		boost::asio::post(core.get_io_context(root), [&acceptor] { acceptor.close(); });
+		while (state.connections_count != 0)
+			std::this_thread::sleep_for(std::chrono::milliseconds{1});
+		core.stop();
+		
+		// Report
+		dkuk::bench::latency_recorder latencies;
+		for (const auto &recorder: recorders)
+			latencies.merge(recorder);
+		
+		const double seconds = std::chrono::duration<double>{elapsed}.count();
+		std::cout
+			<< "connections: " << connections_count
+			<< ", message size: " << message_size
+			<< ", workers: " << workers_count
+			<< ", children: " << children_count << " x " << child_workers_count
+			<< ", poll: " << self_poll_policy << '/' << children_poll_policy
+			<< ", delay: " << delay_policy << std::endl
+			<< std::fixed << std::setprecision(1)
+			<< "requests: " << latencies.size()
+			<< ", requests/sec: " << latencies.size() / seconds << std::endl
+			<< "latency (us): p50 " << dkuk::bench::to_microseconds(latencies.percentile(0.5))
+			<< ", p99 " << dkuk::bench::to_microseconds(latencies.percentile(0.99))
+			<< ", p999 " << dkuk::bench::to_microseconds(latencies.percentile(0.999))
+			<< ", max " << dkuk::bench::to_microseconds(latencies.percentile(1)) << std::endl;
+	} catch (const std::exception &e) {
+		std::cerr << "Error: " << e.what() << '.' << std::endl;
+		return 1;
+	}
+	
+	return 0;
+}
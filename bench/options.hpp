@@ -0,0 +1,156 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 12:03
+
+
+// Command line options of benchmarks. Doesn't depend on the library, so benchmarks of other implementations
+// (see spawn_comparison_cpp20.cpp) use it too.
+
+
+#ifndef DKUK_BENCH_OPTIONS_HPP
+#define DKUK_BENCH_OPTIONS_HPP
+
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace dkuk {
+namespace bench {
+
+
+// Options in form: --name value or --name=value.
+class options
+{
+public:
+	options(
+		int argc,
+		char **argv,
+		std::string usage
+	):
+		usage_{std::move(usage)}
+	{
+		for (int i = 1; i < argc; ++i) {
+			std::string arg = argv[i];
+			if (arg == "--help" || arg == "-h") {
+				std::cout << this->usage_ << std::endl;
+				std::exit(0);
+			}
+			if (arg.compare(0, 2, "--") != 0)
+				throw std::invalid_argument{"Unexpected argument: " + arg};
+			
+			const std::string::size_type eq_pos = arg.find('=');
+			if (eq_pos != std::string::npos) {
+				this->values_[arg.substr(2, eq_pos - 2)] = arg.substr(eq_pos + 1);
+			} else {
+				if (i + 1 == argc)
+					throw std::invalid_argument{"No value for option: " + arg};
+				this->values_[arg.substr(2)] = argv[++i];
+			}
+		}
+	}
+	
+	
+	std::string
+	get_string(
+		const std::string &name,
+		const std::string &default_value
+	)
+	{
+		this->used_.insert(name);
+		const auto it = this->values_.find(name);
+		return (it == this->values_.end())? default_value: it->second;
+	}
+	
+	
+	std::size_t
+	get_size(
+		const std::string &name,
+		std::size_t default_value
+	)
+	{
+		const std::string value = this->get_string(name, std::to_string(default_value));
+		std::size_t pos = 0;
+		const unsigned long long res = std::stoull(value, &pos);
+		if (pos != value.size())
+			throw std::invalid_argument{"Incorrect value of option --" + name + ": " + value};
+		return static_cast<std::size_t>(res);
+	}
+	
+	
+	double
+	get_double(
+		const std::string &name,
+		double default_value
+	)
+	{
+		const std::string value = this->get_string(name, std::to_string(default_value));
+		std::size_t pos = 0;
+		const double res = std::stod(value, &pos);
+		if (pos != value.size())
+			throw std::invalid_argument{"Incorrect value of option --" + name + ": " + value};
+		return res;
+	}
+	
+	
+	// Comma-separated list: --name a,b,c.
+	std::vector<std::string>
+	get_list(
+		const std::string &name,
+		const std::string &default_value
+	)
+	{
+		const std::string value = this->get_string(name, default_value);
+		std::vector<std::string> res;
+		std::string::size_type begin = 0;
+		while (true) {
+			const std::string::size_type end = value.find(',', begin);
+			res.push_back(value.substr(begin, end - begin));
+			if (end == std::string::npos)
+				break;
+			begin = end + 1;
+		}
+		return res;
+	}
+	
+	
+	std::vector<std::size_t>
+	get_size_list(
+		const std::string &name,
+		const std::string &default_value
+	)
+	{
+		std::vector<std::size_t> res;
+		for (const std::string &value: this->get_list(name, default_value)) {
+			std::size_t pos = 0;
+			res.push_back(static_cast<std::size_t>(std::stoull(value, &pos)));
+			if (pos != value.size())
+				throw std::invalid_argument{"Incorrect value of option --" + name + ": " + value};
+		}
+		return res;
+	}
+	
+	
+	// Call after all get_*(): typos in option names are errors.
+	void
+	check_unknown() const
+	{
+		for (const auto &p: this->values_)
+			if (this->used_.count(p.first) == 0)
+				throw std::invalid_argument{"Unknown option: --" + p.first + '\n' + this->usage_};
+	}
+private:
+	std::string usage_;
+	std::map<std::string, std::string> values_;
+	std::set<std::string> used_;
+};	// class options
+
+
+};	// namespace bench
+};	// namespace dkuk
+
+
+#endif	// DKUK_BENCH_OPTIONS_HPP
@@ -0,0 +1,240 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 07:47
+
+
+// Scalability benchmark: throughput of async_core depending on workers count and context tree shape.
+//
+// For each configuration (workers x depth x fan-out x handler mix) the benchmark builds context tree: root context
+// with --workers workers and full tree of child contexts below it (depth 0 means root only, depth 1 means root and
+// fan-out children, etc.). All workers belong to the root, so they poll all contexts (worker_run_multiple_ loops,
+// or worker_run_single_, if root is the only context). Each context has --tasks tasks in flight: each task reposts
+// itself to its context after execution, so contexts are never empty.
+//
+// Handler mixes:
+// - empty: handlers do nothing (measures overhead of the core itself);
+// - cpu:   each handler does --cpu-work iterations of arithmetic;
+// - mixed: half of tasks are empty, half are CPU-bound.
+//
+// Output per configuration: handlers/sec, CPU utilization (process CPU time / (wall time * workers)) and idle
+// rounds share of workers (see async_core::worker::statistics): high share means workers spin over empty contexts.
+
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+
+#include <dkuk/async_core.hpp>
+
+#include "common.hpp"
+
+
+namespace {
+
+
+const char usage[] =
+	"Usage: scalability [options]\n"
+	"  --workers LIST       workers counts (default: 1,2,4)\n"
+	"  --depths LIST        tree depths below the root (default: 0,1,2)\n"
+	"  --fanouts LIST       children of each context (default: 2,4)\n"
+	"  --mixes LIST         handler mixes: empty|cpu|mixed (default: empty,cpu,mixed)\n"
+	"  --tasks N            tasks in flight per context (default: 16)\n"
+	"  --cpu-work N         iterations of CPU-bound handler (default: 2000)\n"
+	"  --duration S         seconds per configuration (default: 0.5)\n"
+	"  --self-poll P        self poll policy: poll_one|poll_all|run_one (default: poll_all)\n"
+	"  --poll P             children poll policy: poll_one|poll_all|run_one (default: poll_one)\n"
+	"  --delay D            delay policy: no_delay|yield|sleep (default: yield)\n"
+	"  --delay-us N         delay for sleep policy in microseconds (default: 100)\n"
+	"  --delay-rounds N     idle rounds before delay (default: 1)";
+
+
+
+thread_local volatile std::uint64_t cpu_work_sink;
+
+
+// Task, which reposts itself to its io_context after execution.
+class task
+{
+public:
+	task(
+		boost::asio::io_context &io_context,
+		std::size_t cpu_work
+	) noexcept:
+		io_context_ptr_{&io_context},
+		cpu_work_{cpu_work}
+	{}
+	
+	
+	void
+	operator()() const
+	{
+		std::uint64_t x = this->cpu_work_;
+		for (std::size_t i = 0; i < this->cpu_work_; ++i)
+			x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+		if (this->cpu_work_ != 0)
+			cpu_work_sink = x;
+		
+		boost::asio::post(*this->io_context_ptr_, *this);
+	}
+private:
+	boost::asio::io_context *io_context_ptr_;
+	std::size_t cpu_work_;
+};	// class task
+
+
+
+struct configuration
+{
+	std::size_t workers_count;
+	std::size_t depth;
+	std::size_t fanout;
+	std::string mix;
+};	// struct configuration
+
+
+
+struct result
+{
+	std::size_t contexts_count;
+	double handlers_per_second;
+	double cpu_utilization;
+	double idle_rounds_share;
+};	// struct result
+
+
+
+result
+run_configuration(
+	const configuration &c,
+	const dkuk::async_core::worker::parameters &worker_parameters,
+	std::size_t tasks_count,
+	std::size_t cpu_work,
+	double duration
+)
+{
+	dkuk::async_core::context_tree t;
+	const auto root = t.add_context(0, 0);
+	for (std::size_t i = 0; i < c.workers_count; ++i)
+		t.add_worker(root, worker_parameters);
+	
+	std::vector<dkuk::async_core::context_id_type> contexts{root}, level{root};
+	for (std::size_t d = 0; d < c.depth; ++d) {
+		std::vector<dkuk::async_core::context_id_type> next_level;
+		for (const auto parent_id: level)
+			for (std::size_t i = 0; i < c.fanout; ++i)
+				next_level.push_back(t.add_context(parent_id, 0));
+		contexts.insert(contexts.end(), next_level.begin(), next_level.end());
+		level.swap(next_level);
+	}
+	
+	dkuk::async_core core{t, false};
+	for (const auto context_id: contexts) {
+		boost::asio::io_context &io_context = core.get_io_context(context_id);
+		for (std::size_t i = 0; i < tasks_count; ++i) {
+			const bool cpu_bound = c.mix == "cpu" || (c.mix == "mixed" && i % 2 == 1);
+			boost::asio::post(io_context, task{io_context, cpu_bound? cpu_work: 0});
+		}
+	}
+	
+	const std::clock_t cpu_start = std::clock();
+	const auto start = std::chrono::steady_clock::now();
+	core.start();
+	std::this_thread::sleep_for(std::chrono::duration<double>{duration});
+	core.stop();
+	const double seconds = std::chrono::duration<double>{std::chrono::steady_clock::now() - start}.count();
+	const double cpu_seconds = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+	
+	const dkuk::async_core::worker::statistics statistics = core.get_worker_statistics(root);
+	
+	result res;
+	res.contexts_count      = contexts.size();
+	res.handlers_per_second = statistics.handlers_executed / seconds;
+	res.cpu_utilization     = cpu_seconds / (seconds * c.workers_count);
+	res.idle_rounds_share   =
+		(statistics.rounds == 0)? 0: static_cast<double>(statistics.idle_rounds) / statistics.rounds;
+	return res;
+}
+
+
+};	// namespace
+
+
+
+int
+main(
+	int argc,
+	char **argv
+)
+{
+	try {
+		dkuk::bench::options options{argc, argv, usage};
+		const std::vector<std::size_t> workers_counts       = options.get_size_list("workers", "1,2,4");
+		const std::vector<std::size_t> depths               = options.get_size_list("depths", "0,1,2");
+		const std::vector<std::size_t> fanouts              = options.get_size_list("fanouts", "2,4");
+		const std::vector<std::string> mixes                = options.get_list("mixes", "empty,cpu,mixed");
+		const std::size_t              tasks_count          = options.get_size("tasks", 16);
+		const std::size_t              cpu_work             = options.get_size("cpu-work", 2000);
+		const double                   duration             = options.get_double("duration", 0.5);
+		const std::string              self_poll_policy     = options.get_string("self-poll", "poll_all");
+		const std::string              children_poll_policy = options.get_string("poll", "poll_one");
+		const std::string              delay_policy         = options.get_string("delay", "yield");
+		const std::size_t              delay_us             = options.get_size("delay-us", 100);
+		const std::size_t              delay_rounds         = options.get_size("delay-rounds", 1);
+		options.check_unknown();
+		
+		for (const auto &mix: mixes)
+			if (mix != "empty" && mix != "cpu" && mix != "mixed")
+				throw std::invalid_argument{"Unknown handler mix: " + mix};
+		for (const auto workers_count: workers_counts)
+			if (workers_count == 0)
+				throw std::invalid_argument{"Workers count should be positive"};
+		if (tasks_count == 0)
+			throw std::invalid_argument{"Tasks count should be positive"};
+		
+		dkuk::async_core::worker::parameters worker_parameters;
+		worker_parameters.self_poll_policy     = dkuk::bench::parse_poll_policy(self_poll_policy);
+		worker_parameters.children_poll_policy = dkuk::bench::parse_poll_policy(children_poll_policy);
+		worker_parameters.delay_policy         = dkuk::bench::parse_delay_policy(delay_policy);
+		worker_parameters.delay_value          = std::chrono::microseconds{delay_us};
+		worker_parameters.delay_rounds         = delay_rounds;
+		worker_parameters.statistics           = true;
+		
+		std::cout
+			<< "poll: " << self_poll_policy << '/' << children_poll_policy
+			<< ", delay: " << delay_policy << ", tasks per context: " << tasks_count
+			<< ", cpu work: " << cpu_work << std::endl
+			<< std::setw(8) << "workers" << std::setw(7) << "depth" << std::setw(8) << "fanout"
+			<< std::setw(10) << "contexts" << std::setw(7) << "mix"
+			<< std::setw(16) << "handlers/sec" << std::setw(8) << "cpu %" << std::setw(8) << "idle %" << std::endl
+			<< std::fixed;
+		
+		for (const auto &mix: mixes)
+			for (const auto depth: depths)
+				for (const auto fanout: fanouts) {
+					if (depth == 0 && fanout != fanouts.front())	// Fan-out doesn't matter for root only
+						continue;
+					
+					for (const auto workers_count: workers_counts) {
+						const configuration c{workers_count, depth, fanout, mix};
+						const result r = run_configuration(c, worker_parameters, tasks_count, cpu_work, duration);
+						std::cout
+							<< std::setw(8) << workers_count << std::setw(7) << depth << std::setw(8) << fanout
+							<< std::setw(10) << r.contexts_count << std::setw(7) << mix
+							<< std::setprecision(0) << std::setw(16) << r.handlers_per_second
+							<< std::setprecision(1) << std::setw(8) << r.cpu_utilization * 100
+							<< std::setw(8) << r.idle_rounds_share * 100 << std::endl;
+					}
+				}
+	} catch (const std::exception &e) {
+		std::cerr << "Error: " << e.what() << '.' << std::endl;
+		return 1;
+	}
+	
+	return 0;
+}
@@ -0,0 +1,245 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 07:54
+
+
+// Comparative benchmark of coroutine implementations on the same io_context (one thread):
+// - dkuk:  dkuk::spawn (Boost.Context, this library);
+// - asio:  boost::asio::spawn (Boost.Coroutine).
+// C++20 coroutines (boost::asio::co_spawn) are measured by spawn_comparison_cpp20: this library requires Boost
+// older than 1.70, and co_spawn appeared in 1.70, so they can't be built in one program. Both print the same table.
+//
+// Measurements:
+// - spawn:  time to spawn and complete an empty coroutine (--spawns coroutines, spawned and run by batches of
+//           --spawn-batch: dkuk::spawn allocates stack immediately, other implementations do it, when coroutine
+//           starts, so huge batches measure mostly memory allocation);
+// - post:   suspend/resume round trip through boost::asio::post() (--switches times in one coroutine);
+// - timer:  suspend/resume round trip through expired steady_timer::async_wait();
+// - idle:   memory per coroutine, suspended on a shared timer (--idle coroutines): resident and virtual (stacks are
+//           reserved, but touched partially), read from /proc/self/status (Linux only, "n/a" otherwise);
+// - per GiB: how many idle coroutines fit 1 GiB of resident memory.
+//
+// NOTE: Memory freed by one implementation may be reused by the next one, so for accurate memory numbers run one
+//       implementation per process: --impls dkuk, then --impls asio, etc. Idle coroutines are measured first.
+// NOTE: Stackful coroutines are limited by virtual memory too: each stack allocated with mmap takes one memory map
+//       (see vm.max_map_count on Linux).
+
+
+#define BOOST_COROUTINES_NO_DEPRECATION_WARNING
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <dkuk/coroutine.hpp>
+
+#include "options.hpp"
+#include "spawn_comparison.hpp"
+
+
+namespace {
+
+
+const char usage[] =
+	"Usage: spawn_comparison [options]\n"
+	"  --impls LIST         implementations: dkuk|asio (default: all)";
+
+
+
+// Implementations (see spawn_comparison.hpp).
+struct dkuk_impl
+{
+	static constexpr const char *name = "dkuk";
+	
+	
+	static
+	void
+	spawn_empty(
+		boost::asio::io_context &io_context,
+		std::size_t &completed
+	)
+	{
+		dkuk::spawn(io_context, [&completed](dkuk::coroutine_context) { ++completed; });
+	}
+	
+	
+	static
+	void
+	spawn_post_loop(
+		boost::asio::io_context &io_context,
+		std::size_t switches_count
+	)
+	{
+		dkuk::spawn(
+			io_context,
+			[&io_context, switches_count](dkuk::coroutine_context context)
+			{
+				for (std::size_t i = 0; i < switches_count; ++i)
+					boost::asio::post(io_context, context);
+			}
+		);
+	}
+	
+	
+	static
+	void
+	spawn_timer_loop(
+		boost::asio::io_context &io_context,
+		std::size_t switches_count
+	)
+	{
+		dkuk::spawn(
+			io_context,
+			[&io_context, switches_count](dkuk::coroutine_context context)
+			{
+				boost::asio::steady_timer timer{io_context};
+				for (std::size_t i = 0; i < switches_count; ++i) {
+					timer.expires_after(std::chrono::nanoseconds::zero());
+					timer.async_wait(context);
+				}
+			}
+		);
+	}
+	
+	
+	static
+	void
+	spawn_idle(
+		boost::asio::io_context &io_context,
+		boost::asio::steady_timer &timer,
+		std::size_t &started
+	)
+	{
+		dkuk::spawn(
+			io_context,
+			[&timer, &started](dkuk::coroutine_context context)
+			{
+				++started;
+				boost::system::error_code ec;
+				timer.async_wait(context[ec]);	// Cancelled
+			}
+		);
+	}
+};	// struct dkuk_impl
+
+
+
+struct asio_impl
+{
+	static constexpr const char *name = "asio";
+	
+	
+	static
+	void
+	spawn_empty(
+		boost::asio::io_context &io_context,
+		std::size_t &completed
+	)
+	{
+		boost::asio::spawn(io_context, [&completed](boost::asio::yield_context) { ++completed; });
+	}
+	
+	
+	static
+	void
+	spawn_post_loop(
+		boost::asio::io_context &io_context,
+		std::size_t switches_count
+	)
+	{
+		boost::asio::spawn(
+			io_context,
+			[&io_context, switches_count](boost::asio::yield_context yield)
+			{
+				for (std::size_t i = 0; i < switches_count; ++i)
+					boost::asio::post(io_context, yield);
+			}
+		);
+	}
+	
+	
+	static
+	void
+	spawn_timer_loop(
+		boost::asio::io_context &io_context,
+		std::size_t switches_count
+	)
+	{
+		boost::asio::spawn(
+			io_context,
+			[&io_context, switches_count](boost::asio::yield_context yield)
+			{
+				boost::asio::steady_timer timer{io_context};
+				for (std::size_t i = 0; i < switches_count; ++i) {
+					timer.expires_after(std::chrono::nanoseconds::zero());
+					timer.async_wait(yield);
+				}
+			}
+		);
+	}
+	
+	
+	static
+	void
+	spawn_idle(
+		boost::asio::io_context &io_context,
+		boost::asio::steady_timer &timer,
+		std::size_t &started
+	)
+	{
+		boost::asio::spawn(
+			io_context,
+			[&timer, &started](boost::asio::yield_context yield)
+			{
+				++started;
+				boost::system::error_code ec;
+				timer.async_wait(yield[ec]);	// Cancelled
+			}
+		);
+	}
+};	// struct asio_impl
+
+
+};	// namespace
+
+
+
+int
+main(
+	int argc,
+	char **argv
+)
+{
+	try {
+		dkuk::bench::options options{
+			argc,
+			argv,
+			std::string{usage} + '\n' + dkuk::bench::spawn_comparison::options_usage
+		};
+		const std::vector<std::string> impls = options.get_list("impls", "dkuk,asio");
+		const dkuk::bench::spawn_comparison::parameters parameters{options};
+		options.check_unknown();
+		
+		boost::asio::io_context io_context{1};
+		
+		dkuk::bench::spawn_comparison::print_header();
+		for (const auto &impl: impls) {
+			if (impl == "dkuk")
+				dkuk::bench::spawn_comparison::run_implementation<dkuk_impl>(io_context, parameters);
+			else if (impl == "asio")
+				dkuk::bench::spawn_comparison::run_implementation<asio_impl>(io_context, parameters);
+			else
+				throw std::invalid_argument{"Unknown implementation: " + impl + " (cpp20: see spawn_comparison_cpp20)"};
+		}
+	} catch (const std::exception &e) {
+		std::cerr << "Error: " << e.what() << '.' << std::endl;
+		return 1;
+	}
+	
+	return 0;
+}
@@ -0,0 +1,218 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 12:03
+
+
+// Measurements and report of spawn_comparison benchmarks (see spawn_comparison.cpp). Implementation (Impl) is a class
+// with static functions spawning coroutines, which do the same things:
+// - spawn_empty(io_context, completed):             increments completed;
+// - spawn_post_loop(io_context, switches_count):    suspends and resumes through boost::asio::post();
+// - spawn_timer_loop(io_context, switches_count):   suspends and resumes through expired steady_timer::async_wait();
+// - spawn_idle(io_context, timer, started):         increments started, then waits for the timer until it's cancelled.
+// Counters are not atomic: all coroutines run in one thread.
+//
+// Doesn't depend on the library, so C++20 coroutines are measured by separate program (see spawn_comparison_cpp20.cpp)
+// and reported in the same table.
+
+
+#ifndef DKUK_BENCH_SPAWN_COMPARISON_HPP
+#define DKUK_BENCH_SPAWN_COMPARISON_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include "options.hpp"
+
+
+namespace dkuk {
+namespace bench {
+namespace spawn_comparison {
+
+
+const char options_usage[] =
+	"  --spawns N           coroutines to spawn (default: 100000)\n"
+	"  --spawn-batch N      coroutines spawned before run (default: 100)\n"
+	"  --switches N         suspend/resume round trips (default: 1000000)\n"
+	"  --idle N             idle coroutines for memory measurement (default: 10000)";
+
+
+
+struct parameters
+{
+	// Reads options listed in options_usage.
+	explicit
+	parameters(
+		bench::options &options
+	):
+		spawns_count{options.get_size("spawns", 100000)},
+		spawn_batch_size{options.get_size("spawn-batch", 100)},
+		switches_count{options.get_size("switches", 1000000)},
+		idle_count{options.get_size("idle", 10000)}
+	{
+		if (this->spawns_count == 0 || this->spawn_batch_size == 0
+			|| this->switches_count == 0 || this->idle_count == 0)
+			throw std::invalid_argument{"Counts should be positive"};
+	}
+	
+	
+	
+	const std::size_t spawns_count, spawn_batch_size, switches_count, idle_count;
+};	// struct parameters
+
+
+
+struct memory_usage
+{
+	std::size_t resident_kib = 0;
+	std::size_t virtual_kib  = 0;
+};	// struct memory_usage
+
+
+inline
+memory_usage
+get_memory_usage()
+{
+	memory_usage res;
+	std::ifstream status{"/proc/self/status"};
+	std::string line;
+	while (std::getline(status, line)) {
+		std::istringstream stream{line};
+		std::string name;
+		std::size_t value;
+		if (!(stream >> name >> value))
+			continue;
+		if (name == "VmRSS:")
+			res.resident_kib = value;
+		else if (name == "VmSize:")
+			res.virtual_kib = value;
+	}
+	return res;
+}
+
+
+
+template<class Duration>
+inline
+double
+per_operation_ns(
+	Duration duration,
+	std::size_t operations_count
+)
+{
+	return std::chrono::duration<double, std::nano>{duration}.count() / operations_count;
+}
+
+
+template<class F>
+inline
+std::chrono::steady_clock::duration
+measure(
+	boost::asio::io_context &io_context,
+	F &&f
+)
+{
+	const auto start = std::chrono::steady_clock::now();
+	f();
+	io_context.run();
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	io_context.restart();
+	return elapsed;
+}
+
+
+// Prints one row of the table (see print_header()).
+template<class Impl>
+void
+run_implementation(
+	boost::asio::io_context &io_context,
+	const parameters &parameters
+)
+{
+	const std::size_t spawns_count     = parameters.spawns_count;
+	const std::size_t spawn_batch_size = parameters.spawn_batch_size;
+	const std::size_t switches_count   = parameters.switches_count;
+	const std::size_t idle_count       = parameters.idle_count;
+	
+	// Idle coroutines
+	boost::asio::steady_timer timer{io_context, std::chrono::hours{1}};
+	std::size_t started = 0;
+	const memory_usage before = get_memory_usage();
+	for (std::size_t i = 0; i < idle_count; ++i)
+		Impl::spawn_idle(io_context, timer, started);
+	while (started < idle_count)
+		io_context.poll();
+	const memory_usage after = get_memory_usage();
+	timer.cancel();
+	io_context.run();
+	io_context.restart();
+	
+	const double resident_per_coroutine =
+		(after.resident_kib > before.resident_kib)? (after.resident_kib - before.resident_kib) * 1024.0 / idle_count: 0;
+	const double virtual_per_coroutine =
+		(after.virtual_kib > before.virtual_kib)? (after.virtual_kib - before.virtual_kib) * 1024.0 / idle_count: 0;
+	
+	// Spawn
+	std::size_t completed = 0;
+	std::chrono::steady_clock::duration spawn_elapsed{};
+	for (std::size_t spawned = 0; spawned < spawns_count; spawned += spawn_batch_size) {
+		const std::size_t batch_size = std::min(spawn_batch_size, spawns_count - spawned);
+		spawn_elapsed += measure(
+			io_context,
+			[&]
+			{
+				for (std::size_t i = 0; i < batch_size; ++i)
+					Impl::spawn_empty(io_context, completed);
+			}
+		);
+	}
+	if (completed != spawns_count)
+		throw std::logic_error{std::string{Impl::name} + ": not all coroutines completed"};
+	
+	// Switches
+	const auto post_elapsed  = measure(io_context, [&] { Impl::spawn_post_loop(io_context, switches_count); });
+	const auto timer_elapsed = measure(io_context, [&] { Impl::spawn_timer_loop(io_context, switches_count); });
+	
+	std::cout
+		<< std::setw(6) << Impl::name
+		<< std::setprecision(1)
+		<< std::setw(11) << per_operation_ns(spawn_elapsed, spawns_count)
+		<< std::setw(10) << per_operation_ns(post_elapsed, switches_count)
+		<< std::setw(10) << per_operation_ns(timer_elapsed, switches_count)
+		<< std::setprecision(0);
+	if (before.resident_kib != 0)
+		std::cout
+			<< std::setw(14) << resident_per_coroutine
+			<< std::setw(14) << virtual_per_coroutine
+			<< std::setw(12) << 1024.0 * 1024 * 1024 / std::max(resident_per_coroutine, 1.0);
+	else
+		std::cout << std::setw(14) << "n/a" << std::setw(14) << "n/a" << std::setw(12) << "n/a";
+	std::cout << std::endl;
+}
+
+
+
+inline
+void
+print_header()
+{
+	std::cout
+		<< std::setw(6) << "impl" << std::setw(11) << "spawn ns" << std::setw(10) << "post ns"
+		<< std::setw(10) << "timer ns" << std::setw(14) << "idle rss B" << std::setw(14) << "idle virt B"
+		<< std::setw(12) << "per GiB" << std::endl
+		<< std::fixed;
+}
+
+
+};	// namespace spawn_comparison
+};	// namespace bench
+};	// namespace dkuk
+
+
+#endif	// DKUK_BENCH_SPAWN_COMPARISON_HPP
@@ -0,0 +1,178 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 12:03
+
+
+// C++20 coroutines baseline for spawn_comparison: boost::asio::co_spawn measured the same way and reported in the
+// same table. Doesn't include the library's headers: co_spawn requires Boost 1.70+, where the library can't be
+// built (see spawn_comparison.cpp).
+//
+// Requires compiler and Boost support, for example: -std=c++20 with GCC 11+ (-fcoroutines with GCC 10) and
+// Boost 1.70+. Otherwise the program only reports, that C++20 coroutines are not supported by the build.
+
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/system/system_error.hpp>
+#include <boost/version.hpp>
+
+#if BOOST_VERSION >= 107000 && defined(BOOST_ASIO_HAS_CO_AWAIT)
+#	include <boost/asio/awaitable.hpp>
+#	include <boost/asio/co_spawn.hpp>
+#	include <boost/asio/detached.hpp>
+#	include <boost/asio/use_awaitable.hpp>
+#	define DKUK_BENCH_HAS_CO_SPAWN
+#endif	// BOOST_VERSION >= 107000 && defined(BOOST_ASIO_HAS_CO_AWAIT)
+
+#include "options.hpp"
+#include "spawn_comparison.hpp"
+
+
+namespace {
+
+
+const char usage[] = "Usage: spawn_comparison_cpp20 [options]";
+
+
+
+#ifdef DKUK_BENCH_HAS_CO_SPAWN
+struct cpp20_impl
+{
+	static constexpr const char *name = "cpp20";
+	
+	
+	static
+	void
+	spawn_empty(
+		boost::asio::io_context &io_context,
+		std::size_t &completed
+	)
+	{
+		boost::asio::co_spawn(io_context, empty(completed), boost::asio::detached);
+	}
+	
+	
+	static
+	void
+	spawn_post_loop(
+		boost::asio::io_context &io_context,
+		std::size_t switches_count
+	)
+	{
+		boost::asio::co_spawn(io_context, post_loop(io_context, switches_count), boost::asio::detached);
+	}
+	
+	
+	static
+	void
+	spawn_timer_loop(
+		boost::asio::io_context &io_context,
+		std::size_t switches_count
+	)
+	{
+		boost::asio::co_spawn(io_context, timer_loop(io_context, switches_count), boost::asio::detached);
+	}
+	
+	
+	static
+	void
+	spawn_idle(
+		boost::asio::io_context &io_context,
+		boost::asio::steady_timer &timer,
+		std::size_t &started
+	)
+	{
+		boost::asio::co_spawn(io_context, idle(timer, started), boost::asio::detached);
+	}
+private:
+	static
+	boost::asio::awaitable<void>
+	empty(
+		std::size_t &completed
+	)
+	{
+		++completed;
+		co_return;
+	}
+	
+	
+	static
+	boost::asio::awaitable<void>
+	post_loop(
+		boost::asio::io_context &io_context,
+		std::size_t switches_count
+	)
+	{
+		for (std::size_t i = 0; i < switches_count; ++i)
+			co_await boost::asio::post(io_context, boost::asio::use_awaitable);
+	}
+	
+	
+	static
+	boost::asio::awaitable<void>
+	timer_loop(
+		boost::asio::io_context &io_context,
+		std::size_t switches_count
+	)
+	{
+		boost::asio::steady_timer timer{io_context};
+		for (std::size_t i = 0; i < switches_count; ++i) {
+			timer.expires_after(std::chrono::nanoseconds::zero());
+			co_await timer.async_wait(boost::asio::use_awaitable);
+		}
+	}
+	
+	
+	static
+	boost::asio::awaitable<void>
+	idle(
+		boost::asio::steady_timer &timer,
+		std::size_t &started
+	)
+	{
+		++started;
+		try {
+			co_await timer.async_wait(boost::asio::use_awaitable);
+		} catch (const boost::system::system_error &) {}	// Cancelled
+	}
+};	// struct cpp20_impl
+#endif	// DKUK_BENCH_HAS_CO_SPAWN
+
+
+};	// namespace
+
+
+
+int
+main(
+	int argc,
+	char **argv
+)
+{
+	try {
+		dkuk::bench::options options{
+			argc,
+			argv,
+			std::string{usage} + '\n' + dkuk::bench::spawn_comparison::options_usage
+		};
+		const dkuk::bench::spawn_comparison::parameters parameters{options};
+		options.check_unknown();
+		
+#ifdef DKUK_BENCH_HAS_CO_SPAWN
+		boost::asio::io_context io_context{1};
+		
+		dkuk::bench::spawn_comparison::print_header();
+		dkuk::bench::spawn_comparison::run_implementation<cpp20_impl>(io_context, parameters);
+#else	// DKUK_BENCH_HAS_CO_SPAWN
+		throw std::invalid_argument{"C++20 coroutines are not supported by this build"};
+#endif	// DKUK_BENCH_HAS_CO_SPAWN
+	} catch (const std::exception &e) {
+		std::cerr << "Error: " << e.what() << '.' << std::endl;
+		return 1;
+	}
+	
+	return 0;
+}
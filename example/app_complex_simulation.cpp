@@ -0,0 +1,206 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 08:21
+
+
+// This example reproduces app_complex.cpp scenario in async_core_simulator and compares worker policies of root
+// workers. Each variant simulates 10 minutes of virtual time in a fraction of second, and results are the same
+// on each run.
+//
+// Application and architecture details (see app_complex.cpp):
+// - 1 io_context and 1 worker for lightweight tasks (0.3s);
+// - 1 io_context and 1 worker for heavyweight tasks (5s);
+// - 5 universal workers (can execute tasks from both io_contexts), their parameters differ between variants;
+// - 90% of all tasks are lightweight;
+// - producer keeps 200 tasks in flight, it wakes up every 0-5 seconds.
+//
+// All workers of app_complex are always busy with 200 tasks in flight, so delay policies don't matter there,
+// but policy of children polling does. Variants are also compared with 5 tasks in flight, when workers are idle
+// sometimes: spinning workers burn CPU, and long sleeps increase latency.
+//
+// Output table columns:
+// - variant of root workers' parameters
+// - executed lightweight / heavyweight tasks
+// - mean and 99th percentile latency of lightweight tasks (in seconds)
+// - busy and overhead (polls and yields) CPU time of all workers (percents of simulated time)
+
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <dkuk/async_core.hpp>
+#include <dkuk/async_core_simulator.hpp>
+
+
+namespace {
+
+
+constexpr std::chrono::milliseconds::rep
+	lw_task_ms    = 300,
+	hw_task_ms    = 5000;
+const double
+	lw_tasks_part = 0.90;
+
+constexpr std::size_t
+	root_workers  = 5,
+	lw_workers    = 1,
+	hw_workers    = 1;
+
+
+
+struct variant
+{
+	std::string name;
+	dkuk::async_core::worker::parameters parameters;
+};	// struct variant
+
+
+
+std::vector<variant>
+make_variants()
+{
+	std::vector<variant> res(5);
+	
+	res[0].name = "default (yield)";
+	
+	res[1].name = "no_delay";
+	res[1].parameters.delay_policy = dkuk::async_core::worker::delay::no_delay;
+	
+	res[2].name = "sleep 500ms";
+	res[2].parameters.delay_policy = dkuk::async_core::worker::delay::sleep;
+	
+	res[3].name = "sleep 1ms";
+	res[3].parameters.delay_policy = dkuk::async_core::worker::delay::sleep;
+	res[3].parameters.delay_value  = std::chrono::milliseconds{1};
+	
+	res[4].name = "children poll_all";
+	res[4].parameters.children_poll_policy = dkuk::async_core::worker::poll::poll_all;
+	return res;
+}
+
+
+// Same as post_tasks() of app_complex.cpp: posts new tasks avoiding too many tasks and reschedules itself.
+class producer
+{
+public:
+	producer(
+		dkuk::async_core_simulator &simulator,
+		dkuk::async_core::context_id_type lw_context,
+		dkuk::async_core::context_id_type hw_context,
+		std::size_t tasks_limit
+	) noexcept:
+		simulator_ptr_{&simulator},
+		lw_context_{lw_context},
+		hw_context_{hw_context},
+		tasks_limit_{tasks_limit}
+	{}
+	
+	
+	void
+	operator()()
+	{
+		dkuk::async_core_simulator &s = *this->simulator_ptr_;
+		const auto lw = s.get_context_statistics(this->lw_context_), hw = s.get_context_statistics(this->hw_context_);
+		for (
+			std::size_t in_flight = lw.tasks_posted + hw.tasks_posted - lw.tasks_executed - hw.tasks_executed;
+			in_flight < this->tasks_limit_;
+			++in_flight
+		) {
+			if (this->is_lw_task_dist_(this->gen_))
+				s.post(this->lw_context_, std::chrono::milliseconds{lw_task_ms});
+			else
+				s.post(this->hw_context_, std::chrono::milliseconds{hw_task_ms});
+		}
+		
+		const std::chrono::seconds delay{this->sleep_seconds_dist_(this->gen_)};	// Before copy of the generator
+		s.schedule(delay, *this);
+	}
+private:
+	dkuk::async_core_simulator *simulator_ptr_;
+	dkuk::async_core::context_id_type lw_context_, hw_context_;
+	std::size_t tasks_limit_;
+	
+	std::minstd_rand gen_;
+	std::uniform_int_distribution<std::chrono::seconds::rep> sleep_seconds_dist_{0, 5};
+	std::bernoulli_distribution is_lw_task_dist_{lw_tasks_part};
+};	// class producer
+
+
+
+inline
+double
+to_seconds(
+	dkuk::async_core_simulator::duration d
+)
+{
+	return std::chrono::duration<double>{d}.count();
+}
+
+
+void
+simulate(
+	const variant &v,
+	std::size_t tasks_limit,
+	std::chrono::seconds duration
+)
+{
+	dkuk::async_core::context_tree t;
+	const auto root_context = t.add_context(0, 0);	// Root context always has id 0
+	const auto lw_context   = t.add_context(root_context, lw_workers);
+	const auto hw_context   = t.add_context(root_context, hw_workers);
+	for (std::size_t i = 0; i < root_workers; ++i)
+		t.add_worker(root_context, v.parameters);
+	
+	dkuk::async_core_simulator s{t};
+	s.schedule(std::chrono::seconds{0}, producer{s, lw_context, hw_context, tasks_limit});
+	s.run_for(duration);
+	
+	dkuk::async_core_simulator::duration busy_time{0}, overhead_time{0};
+	const std::vector<std::pair<dkuk::async_core::context_id_type, std::size_t>> workers = {
+		{root_context, root_workers},
+		{lw_context,   lw_workers},
+		{hw_context,   hw_workers}
+	};
+	for (const auto &p: workers)
+		for (std::size_t i = 0; i < p.second; ++i) {
+			const auto statistics = s.get_worker_statistics(p.first, i);
+			busy_time     += statistics.busy_time;
+			overhead_time += statistics.overhead_time;
+		}
+	
+	const auto lw = s.get_context_statistics(lw_context), hw = s.get_context_statistics(hw_context);
+	const double cpu_seconds = to_seconds(s.now()) * (root_workers + lw_workers + hw_workers) / 100;
+	std::cout
+		<< std::left << std::setw(20) << v.name << std::right
+		<< std::setw(8) << lw.tasks_executed << std::setw(8) << hw.tasks_executed
+		<< std::setprecision(3) << std::setw(10) << to_seconds(lw.mean_latency)
+		<< std::setw(10) << to_seconds(lw.p99_latency)
+		<< std::setprecision(1) << std::setw(8) << to_seconds(busy_time) / cpu_seconds
+		<< std::setprecision(3) << std::setw(12) << to_seconds(overhead_time) / cpu_seconds << std::endl;
+}
+
+
+};	// namespace
+
+
+
+int
+main()
+{
+	const std::chrono::seconds duration = std::chrono::minutes{10};
+	
+	std::cout << "Simulated time: " << duration.count() << " s" << std::endl << std::fixed;
+	for (const std::size_t tasks_limit: {200, 5}) {
+		std::cout
+			<< std::endl << "Tasks in flight: " << tasks_limit << std::endl
+			<< std::left << std::setw(20) << "variant" << std::right
+			<< std::setw(8) << "L" << std::setw(8) << "H" << std::setw(10) << "L mean" << std::setw(10) << "L p99"
+			<< std::setw(8) << "busy %" << std::setw(12) << "overhead %" << std::endl;
+		for (const auto &v: make_variants())
+			simulate(v, tasks_limit, duration);
+	}
+	
+	return 0;
+}
@@ -0,0 +1,375 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 07:01
+
+
+// Actor: state, which is owned by its mailbox. Messages (function objects, which take State &) are executed one by
+// one by the actor's serial_executor (see serial_executor.hpp), so state is accessed without any locking, and
+// mailbox is processed in batches: one io_context handler executes up to batch_size messages.
+//
+// Usage:
+// dkuk::actor<std::map<std::string, int>> counters{core, context_id, {}};	// Or: counters{io_context, {}}
+//
+// counters.tell([](auto &state) { ++state["requests"]; });	// Fire and forget
+// counters.async_tell([](auto &state) { ++state["requests"]; }, context);	// Waits for place in bounded mailbox
+//
+// dkuk::coroutine_future<int> f = counters.ask([](auto &state) { return state["requests"]; });
+// int requests = f.get(context);	// Or f.get() outside of coroutine
+//
+// NOTE: Bounded mailbox (see parameters::capacity): tell() and ask() throw mailbox_overflow, if the mailbox is full,
+//       try_tell() returns false, async_tell() waits for free place (waiting messages are queued in FIFO order).
+// NOTE: Exceptions thrown by messages are rethrown from io_context's run() (for async_core: passed to its exception
+//       handler), actor continues processing. Exceptions thrown by ask() messages are returned through futures.
+// NOTE: Messages, which are already in the mailbox, are executed even after the actor object destruction.
+//
+// Thread-safety:
+// - actor:
+//     + distinct objects: safe;
+//     + shared object: safe.
+
+
+#ifndef DKUK_ACTOR_HPP
+#define DKUK_ACTOR_HPP
+
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+
+#include <dkuk/coroutine.hpp>
+#include <dkuk/detail/function_node.hpp>
+#include <dkuk/serial_executor.hpp>
+
+
+namespace dkuk {
+
+
+class mailbox_overflow: public std::runtime_error
+{
+public:
+	inline
+	mailbox_overflow():
+		std::runtime_error{"Mailbox overflow"}
+	{}
+};	// class mailbox_overflow
+
+
+
+template<class State>
+class actor
+{
+public:
+	using state_type = State;
+	
+	
+	
+	struct parameters
+	{
+		std::size_t capacity   = 0;	// Max messages in the mailbox, 0: unbounded
+		std::size_t batch_size = 64;	// Max messages per io_context handler (others wait for the next handler)
+	};	// struct parameters
+	
+	
+	
+	actor(
+		boost::asio::io_context &io_context,
+		State state,
+		const parameters &parameters = actor::parameters{}
+	):
+		mailbox_ptr_{std::make_shared<mailbox>(io_context, std::move(state), parameters)}
+	{}
+	
+	
+	// Messages are executed in the context of the core (e.g. async_core).
+	template<class Core>
+	actor(
+		Core &core,
+		typename Core::context_id_type context_id,
+		State state,
+		const parameters &parameters = actor::parameters{}
+	):
+		actor{core.get_io_context(context_id), std::move(state), parameters}
+	{}
+	
+	
+	actor(
+		const actor &other
+	) = delete;
+	
+	
+	actor &
+	operator=(
+		const actor &other
+	) = delete;
+	
+	
+	// Fn signature: void (State &).
+	template<class Fn>
+	inline
+	void
+	tell(
+		Fn &&fn
+	)
+	{
+		if (!this->try_tell(std::forward<Fn>(fn)))
+			throw mailbox_overflow{};
+	}
+	
+	
+	// Returns false, if the mailbox is full.
+	template<class Fn>
+	bool
+	try_tell(
+		Fn &&fn
+	)
+	{
+		if (!actor::reserve_(*this->mailbox_ptr_))
+			return false;
+		actor::push_(this->mailbox_ptr_, std::forward<Fn>(fn));
+		return true;
+	}
+	
+	
+	// Same as tell(), but waits for free place in the bounded mailbox instead of throwing: handler is called, when
+	// the message is queued. Handler signature: void (). Handler may be coroutine_context.
+	template<class Fn, class Handler>
+	auto
+	async_tell(
+		Fn &&fn,
+		Handler &&handler
+	)
+	{
+		boost::asio::async_completion<Handler, void ()> init{handler};
+		
+		mailbox &m = *this->mailbox_ptr_;
+		const auto executor =
+			boost::asio::get_associated_executor(init.completion_handler, m.executor_.context().get_executor());
+		if (actor::reserve_(m)) {
+			actor::push_(this->mailbox_ptr_, std::forward<Fn>(fn));
+			boost::asio::post(executor, std::move(init.completion_handler));
+			return init.result.get();
+		}
+		
+		std::unique_lock<std::mutex> lock{m.waiters_mutex_};
+		++m.waiters_count_;
+		if (actor::reserve_(m)) {	// Place is freed, before the waiter is visible for release_()
+			--m.waiters_count_;
+			lock.unlock();
+			actor::push_(this->mailbox_ptr_, std::forward<Fn>(fn));
+			boost::asio::post(executor, std::move(init.completion_handler));
+			return init.result.get();
+		}
+		
+		m.waiters_.push_back(
+			waiter::make(
+				[
+					fn = std::forward<Fn>(fn),
+					work_guard = boost::asio::make_work_guard(executor),
+					handler = std::move(init.completion_handler)
+				](const std::shared_ptr<mailbox> &mailbox_ptr) mutable
+				{
+					actor::push_(mailbox_ptr, std::move(fn));
+					boost::asio::post(work_guard.get_executor(), std::move(handler));
+					work_guard.reset();
+				}
+			)
+		);
+		lock.unlock();
+		return init.result.get();
+	}
+	
+	
+	// Fn signature: R (State &). Result (or exception) is available through the future.
+	template<class Fn>
+	auto
+	ask(
+		Fn &&fn
+	)
+	{
+		using result_type = decltype(fn(std::declval<State &>()));
+		
+		coroutine_promise<result_type> result_promise{this->get_io_context()};
+		coroutine_future<result_type> result_future = result_promise.get_future();
+		
+		this->tell(
+			[fn = std::forward<Fn>(fn), result_promise = std::move(result_promise)](State &state) mutable
+			{
+				try {
+					actor::set_result_(result_promise, fn, state);
+				} catch (const std::exception & /* e */) {
+					result_promise.set_exception(std::current_exception());
+				}
+			}
+		);
+		return result_future;
+	}
+	
+	
+	inline
+	boost::asio::io_context &
+	get_io_context() const noexcept
+	{
+		return this->mailbox_ptr_->executor_.context();
+	}
+	
+	
+	// Returns executor of the messages: handlers and coroutines spawned there are serialized with the messages.
+	inline
+	const serial_executor &
+	get_executor() const noexcept
+	{
+		return this->mailbox_ptr_->executor_;
+	}
+private:
+	struct mailbox;
+	
+	
+	
+	// Message waiting for place in the bounded mailbox, called by release_() after place reservation
+	using waiter = detail::function_node<void(const std::shared_ptr<mailbox> &)>;
+	
+	
+	
+	// Actor and queued messages own it together: queued message processes the state after the actor is destroyed.
+	struct mailbox
+	{
+		mailbox(
+			boost::asio::io_context &io_context,
+			State &&state,
+			const parameters &parameters
+		):
+			executor_{io_context, parameters.batch_size},
+			state_{std::move(state)},
+			parameters_{parameters}
+		{}
+		
+		
+		
+		serial_executor executor_;
+		State state_;
+		const parameters parameters_;
+		
+		// Bounded mailbox only. Memory order is sequentially consistent: release_() either sees waiters_count_
+		// increased by async_tell(), or async_tell() sees decreased size_.
+		std::atomic<std::size_t> size_{0};	// Reserved by producers, decreased after message execution
+		std::atomic<std::size_t> waiters_count_{0};
+		std::mutex waiters_mutex_;
+		std::deque<std::unique_ptr<waiter>> waiters_;
+	};	// struct mailbox
+	
+	
+	
+	template<class T, class Fn>
+	static inline
+	void
+	set_result_(
+		coroutine_promise<T> &result_promise,
+		Fn &fn,
+		State &state
+	)
+	{
+		result_promise.set_value(fn(state));
+	}
+	
+	
+	template<class Fn>
+	static inline
+	void
+	set_result_(
+		coroutine_promise<void> &result_promise,
+		Fn &fn,
+		State &state
+	)
+	{
+		fn(state);
+		result_promise.set_value();
+	}
+	
+	
+	static
+	bool
+	reserve_(
+		mailbox &m
+	) noexcept
+	{
+		const std::size_t capacity = m.parameters_.capacity;
+		if (capacity == 0)
+			return true;
+		
+		std::size_t size = m.size_.load();
+		do {
+			if (size >= capacity)
+				return false;
+		} while (!m.size_.compare_exchange_weak(size, size + 1));
+		return true;
+	}
+	
+	
+	// Place in the mailbox is already reserved.
+	template<class Fn>
+	static
+	void
+	push_(
+		const std::shared_ptr<mailbox> &mailbox_ptr,
+		Fn &&fn
+	)
+	{
+		mailbox_ptr->executor_.post(
+			[mailbox_ptr, fn = std::forward<Fn>(fn)]() mutable
+			{
+				try {
+					fn(mailbox_ptr->state_);
+				} catch (...) {	// Goes to the io_context's runner, actor continues
+					actor::release_(mailbox_ptr);
+					throw;
+				}
+				actor::release_(mailbox_ptr);
+			}
+		);
+	}
+	
+	
+	// Frees place of the executed message: the first waiter takes it.
+	static
+	void
+	release_(
+		const std::shared_ptr<mailbox> &mailbox_ptr
+	)
+	{
+		mailbox &m = *mailbox_ptr;
+		if (m.parameters_.capacity == 0)
+			return;
+		
+		--m.size_;
+		if (m.waiters_count_.load() == 0)
+			return;
+		
+		std::unique_ptr<waiter> waiter_ptr;
+		{
+			std::lock_guard<std::mutex> lock{m.waiters_mutex_};
+			if (m.waiters_.empty() || !actor::reserve_(m))	// Place is taken by try_tell(): it wakes the waiter later
+				return;
+			waiter_ptr = std::move(m.waiters_.front());
+			m.waiters_.pop_front();
+			--m.waiters_count_;
+		}
+		(*waiter_ptr)(mailbox_ptr);
+	}
+	
+	
+	
+	std::shared_ptr<mailbox> mailbox_ptr_;
+};	// class actor
+
+
+};	// namespace dkuk
+
+
+#endif	// DKUK_ACTOR_HPP
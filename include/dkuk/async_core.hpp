@@ -27,10 +27,15 @@
 //     - Create async_core::context_tree.
 //     - Add contexts with their parent-child relationship. NOTE: Contexts ids guaranteed to be sequence: 0, 1, 2, ...
 //     - Set workers with appropriate parameters for each context.
+//     - Contexts, which can be run by one worker only, get single-threaded concurrency hint automatically
+//       (see context_tree::set_single_worker_concurrency_hint()).
 // 2. Create and start async_core.
-// 3. Using async_core::get_io_context() get your io_contexts, post tasks, etc...
+// 3. Using async_core::get_io_context() get your io_contexts, post tasks, etc... Use async_core::post() and
+//    async_core::try_post() for contexts with bounded queues (see async_core::context::parameters).
 // 4. Use async_core::join() to freeze current thread until async_core::stop() will be called from another thread.
 // 5. When you need to stop, just do all you usually do (close your sockets etc.) and call async_core::stop().
+// 6. Contexts can be added to the running core (see async_core::add_context()) and retired, when they are not
+//    needed anymore (see async_core::retire_context()). Workers of ancestors pick up new contexts automatically.
 // 
 // Why you don't need async_core:
 // - You have single io_context and one or more workers (1) => you can use boost::asio::io_context itself.
@@ -58,9 +63,15 @@
 #ifndef DKUK_ASYNC_CORE_HPP
 #define DKUK_ASYNC_CORE_HPP
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <iterator>
+#include <limits>
+#include <memory>
 #include <mutex>
 #include <new>
 #include <queue>
@@ -70,14 +81,29 @@
 #include <utility>
 #include <vector>
 
+#include <boost/asio/detail/concurrency_hint.hpp>
 #include <boost/asio/executor_work_guard.hpp>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/optional.hpp>
 
+#include <dkuk/detail/function_node.hpp>
+
 
 namespace dkuk {
 
 
+class context_overflow: public std::runtime_error
+{
+public:
+	inline
+	context_overflow():
+		std::runtime_error{"Context overflow"}
+	{}
+};	// class context_overflow
+
+
+
 class async_core
 {
 public:
@@ -148,11 +174,103 @@ public:
 																// io_context is stopped).
 			delay                    delay_policy         = delay::yield;
 			std::chrono::nanoseconds delay_value          = std::chrono::nanoseconds{default_delay::value};
+			
+			
+			// Collect worker loop statistics (see async_core::get_worker_statistics()). Disabled workers don't
+			// count rounds at all.
+			bool                     statistics           = false;
 		};	// struct parameters
+		
+		
+		
+		// Worker loop statistics, summed over workers of a context (only workers with parameters::statistics enabled
+		// collect them). Round: poll of all worker's contexts (or one
+		// run_one() call for worker of single context). Idle round executes no tasks: high idle rounds share means
+		// workers spin over empty contexts (tune delay settings or use less workers).
+		struct statistics
+		{
+			std::size_t rounds            = 0;
+			std::size_t idle_rounds       = 0;
+			std::size_t delays            = 0;	// See parameters::delay_rounds
+			std::size_t handlers_executed = 0;
+		};	// struct statistics
 	};	// class worker
 	
 	
 	
+	class context
+	{
+	public:
+		// Context scheduling parameters. By default, workers poll contexts according to their poll policies only,
+		// so context with expensive tasks takes more workers' time than context with cheap ones. Set quantum to
+		// enable Deficit Round-Robin: each round context gets quantum of time, and it is polled repeatedly while
+		// its deficit is positive; context, which spent more than its deficit, is skipped in next rounds until
+		// quantum is given back (rounds with skipped contexts are not idle, so workers don't delay, but skips are
+		// not counted as executed handlers). Round of context ends, when each worker polling it has skipped it
+		// once, so context gets one quantum per round regardless of workers count. Time is measured around task
+		// execution.
+		// Rate limits are token buckets, which cap context's tasks rate and share of worker's time (e.g. for
+		// background tasks). Context, which exceeded any of its limits, is skipped by workers until the bucket
+		// refills, and its poll counts as idle (so workers may delay, see worker::parameters).
+		// NOTE: Use poll_one policy for scheduled contexts: poll_all executes all ready tasks regardless of deficit
+		//       and limits.
+		// NOTE: Scheduled contexts are always polled: run_one policy is replaced with poll_one for them, so workers
+		//       never block in them (see worker::poll::run_one).
+		// 
+		// Bounded queue limits number of tasks posted with async_core::post() or async_core::try_post() and not
+		// executed yet. Tasks posted to io_context directly are not limited. Overflow policy is applied, when
+		// the queue is full.
+		// NOTE: Don't use overflow::block for contexts, which tasks post to themselves: worker may block forever.
+		enum class overflow
+		{
+			reject,			// Task is rejected: post() throws context_overflow, try_post() returns false.
+			drop_oldest,	// Oldest task is dropped (destroyed without execution), new task is queued.
+			block,			// Poster is blocked until queue has free space (try_post() rejects task).
+			redirect		// Task is posted to overflow context without blocking (or rejected, if it is full too).
+		};	// enum class overflow
+		
+		
+		
+		struct parameters
+		{
+			// Deficit Round-Robin
+			std::chrono::nanoseconds quantum             = std::chrono::nanoseconds::zero();	// Zero: disabled
+			bool                     accounting          = false;	// Collect statistics (implied by other settings)
+			
+			
+			// Rate limits. Bursts: how much context may execute at once after idle period.
+			double                   handlers_per_second = 0;	// Zero: unlimited
+			std::size_t              handlers_burst      = 1;
+			double                   cpu_share           = 0;	// Share of one worker's time in (0, 1). Zero: unlimited
+			std::chrono::nanoseconds cpu_burst           = std::chrono::milliseconds{10};
+			
+			
+			// Bounded queue
+			std::size_t              capacity            = 0;	// Zero: unbounded
+			overflow                 overflow_policy     = overflow::reject;
+			context_id_type          overflow_context_id = 0;	// For overflow::redirect
+		};	// struct parameters
+		
+		
+		
+		struct statistics
+		{
+			// Scheduling
+			std::size_t              handlers_executed = 0;
+			std::chrono::nanoseconds execution_time    = std::chrono::nanoseconds::zero();
+			std::chrono::nanoseconds deficit           = std::chrono::nanoseconds::zero();
+			
+			
+			// Bounded queue
+			std::size_t              queue_size        = 0;	// Tasks waiting in the queue now
+			std::size_t              tasks_rejected    = 0;
+			std::size_t              tasks_dropped     = 0;
+			std::size_t              tasks_redirected  = 0;
+		};	// struct statistics
+	};	// class context
+	
+	
+	
 	class context_tree
 	{
 	public:
@@ -177,10 +295,26 @@ public:
 			int concurrency_hint
 		)
 		{
+			async_core::check_concurrency_hint_(concurrency_hint);
 			return this->add_context_(parent_id, workers_count, enabled, concurrency_hint);
 		}
 		
 		
+		inline
+		context_id_type
+		add_context(
+			context_id_type parent_id,
+			std::size_t workers_count,
+			const context::parameters &context_parameters,
+			bool enabled = true
+		)
+		{
+			const context_id_type context_id = this->add_context_(parent_id, workers_count, enabled, boost::none);
+			this->set_context_parameters(context_id, context_parameters);
+			return context_id;
+		}
+		
+		
 		inline
 		void
 		set_worker_parameters(
@@ -219,6 +353,97 @@ public:
 			n.worker_parameters_.emplace_back();
 			return worker_id;
 		}
+		
+		
+		// Concurrency hint for contexts without explicit one, which can be run by one worker only (one thread
+		// polls or runs them). By default, it is BOOST_ASIO_CONCURRENCY_HINT_1: io_context is optimized for single
+		// thread, but tasks still can be posted to it from any thread. Use boost::none to disable automatic hint.
+		// NOTE: Hints disabling scheduler locking (BOOST_ASIO_CONCURRENCY_HINT_UNSAFE) are rejected for any context:
+		//       async_core itself posts to contexts and stops them from other threads (wake ups, stop(), post()).
+		//       BOOST_ASIO_CONCURRENCY_HINT_UNSAFE_IO is allowed, if I/O objects of the context are used from its
+		//       worker thread only.
+		inline
+		void
+		set_single_worker_concurrency_hint(
+			boost::optional<int> concurrency_hint
+		)
+		{
+			if (concurrency_hint)
+				async_core::check_concurrency_hint_(concurrency_hint.get());
+			this->single_worker_concurrency_hint_ = concurrency_hint;
+		}
+		
+		
+		// Returns number of workers, which can run tasks of the context: its own workers and workers of all its
+		// ancestors, which poll children contexts. Disabled contexts are not run by anybody.
+		inline
+		std::size_t
+		get_runners_count(
+			context_id_type context_id
+		) const
+		{
+			return this->runners_counts_().at(context_id);
+		}
+		
+		
+		inline
+		void
+		set_context_parameters(
+			context_id_type context_id,
+			const context::parameters &parameters
+		)
+		{
+			this->nodes_.at(context_id).context_parameters_ = async_core::fixed_context_parameters_(parameters);
+		}
+		
+		
+		// Read access to the tree (e.g. for async_core_simulator).
+		inline
+		std::size_t
+		get_contexts_count() const noexcept
+		{
+			return this->nodes_.size();
+		}
+		
+		
+		inline
+		context_id_type
+		get_parent_id(
+			context_id_type context_id
+		) const
+		{
+			return this->nodes_.at(context_id).parent_id_;
+		}
+		
+		
+		inline
+		bool
+		is_enabled(
+			context_id_type context_id
+		) const
+		{
+			return this->nodes_.at(context_id).enabled_;
+		}
+		
+		
+		inline
+		const std::vector<worker::parameters> &
+		get_worker_parameters(
+			context_id_type context_id
+		) const
+		{
+			return this->nodes_.at(context_id).worker_parameters_;
+		}
+		
+		
+		inline
+		const context::parameters &
+		get_context_parameters(
+			context_id_type context_id
+		) const
+		{
+			return this->nodes_.at(context_id).context_parameters_;
+		}
 	private:
 		friend class async_core;
 		
@@ -244,6 +469,7 @@ public:
 			context_id_type parent_id_;
 			std::size_t children_count_ = 0;
 			std::vector<worker::parameters> worker_parameters_;
+			context::parameters context_parameters_;
 			boost::optional<int> concurrency_hint_;
 			bool enabled_;
 		};	// struct node
@@ -271,8 +497,37 @@ public:
 		}
 		
 		
+		std::vector<std::size_t>
+		runners_counts_() const
+		{
+			std::vector<std::size_t> runners_counts(this->nodes_.size(), 0);
+			std::vector<std::size_t> inherited_runners_counts(this->nodes_.size(), 0);	// Ancestors' workers
+			
+			for (std::size_t i = 0; i < this->nodes_.size(); ++i) {
+				const node &n = this->nodes_[i];
+				
+				std::size_t self_runners = 0, children_runners = 0;
+				for (const worker::parameters &parameters: n.worker_parameters_) {
+					if (parameters.self_poll_policy != worker::poll::disabled)
+						++self_runners;
+					if (parameters.children_poll_policy != worker::poll::disabled)
+						++children_runners;
+				}
+				
+				if (i != 0)	// Parents always go before children
+					inherited_runners_counts[i] = inherited_runners_counts[n.parent_id_];
+				if (n.enabled_)
+					runners_counts[i] = inherited_runners_counts[i] + self_runners;
+				inherited_runners_counts[i] += children_runners;
+			}
+			
+			return runners_counts;
+		}
+		
+		
 		
 		std::vector<node> nodes_;
+		boost::optional<int> single_worker_concurrency_hint_ = BOOST_ASIO_CONCURRENCY_HINT_1;
 	};	// class context_tree
 	
 	
@@ -282,10 +537,11 @@ public:
 		exception_handler_type exception_handler,
 		bool start_immediately = true
 	):
-		nodes_{t},
-		nodes_count_{t.nodes_.size()},
+		nodes_{t.nodes_.size()},
+		single_worker_concurrency_hint_{t.single_worker_concurrency_hint_},
 		exception_handler_{std::move(exception_handler)}
 	{
+		this->add_nodes_(t);
 		if (start_immediately)
 			this->start();
 	}
@@ -295,9 +551,10 @@ public:
 		const context_tree &t,
 		bool start_immediately = true
 	):
-		nodes_{t},
-		nodes_count_{t.nodes_.size()}
+		nodes_{t.nodes_.size()},
+		single_worker_concurrency_hint_{t.single_worker_concurrency_hint_}
 	{
+		this->add_nodes_(t);
 		if (start_immediately)
 			this->start();
 	}
@@ -336,6 +593,8 @@ public:
 		std::lock_guard<std::mutex> stop_lock{this->stop_mutex_, std::adopt_lock};
 		this->join_mutex_.unlock();
 		
+		// Contexts added concurrently will be started either here or by add_context() itself
+		std::lock_guard<std::mutex> topology_lock{this->topology_mutex_};
 		this->state_ = state::starting;
 		try {
 			this->start_workers_();
@@ -386,50 +645,320 @@ public:
 	{
 		return this->nodes_.at(context_id).io_context_;
 	}
-private:
-	struct node
+	
+	
+	// Returns concurrency hint, which io_context of the context is constructed with (explicit, automatic
+	// for single-worker contexts, or BOOST_ASIO_CONCURRENCY_HINT_DEFAULT).
+	inline
+	int
+	get_concurrency_hint(
+		context_id_type context_id
+	) const
 	{
-		inline
-		node(
-			std::size_t children_count,
-			const std::vector<worker::parameters> &worker_parameters,
-			bool enabled
-		):
-			worker_parameters_{worker_parameters},
-			enabled_{(enabled)? true: false}
+		return this->nodes_.at(context_id).concurrency_hint_;
+	}
+	
+	
+	// Adds context to the core in any state. If the core is running, workers of new context are launched
+	// immediately, and workers of its ancestors start polling it without stopping the core.
+	// NOTE: New context id is greater than any existing one (ids of retired contexts are not reused).
+	inline
+	context_id_type
+	add_context(
+		context_id_type parent_id,
+		std::size_t workers_count = 0,
+		bool enabled = true
+	)
+	{
+		return this->add_context_(parent_id, std::vector<worker::parameters>(workers_count), {}, enabled, boost::none);
+	}
+	
+	
+	inline
+	context_id_type
+	add_context(
+		context_id_type parent_id,
+		std::size_t workers_count,
+		bool enabled,
+		int concurrency_hint
+	)
+	{
+		async_core::check_concurrency_hint_(concurrency_hint);
+		return this->add_context_(
+			parent_id,
+			std::vector<worker::parameters>(workers_count),
+			{},
+			enabled,
+			concurrency_hint
+		);
+	}
+	
+	
+	inline
+	context_id_type
+	add_context(
+		context_id_type parent_id,
+		std::vector<worker::parameters> worker_parameters,
+		bool enabled = true
+	)
+	{
+		return this->add_context_(parent_id, std::move(worker_parameters), {}, enabled, boost::none);
+	}
+	
+	
+	inline
+	context_id_type
+	add_context(
+		context_id_type parent_id,
+		std::vector<worker::parameters> worker_parameters,
+		bool enabled,
+		int concurrency_hint
+	)
+	{
+		async_core::check_concurrency_hint_(concurrency_hint);
+		return this->add_context_(parent_id, std::move(worker_parameters), {}, enabled, concurrency_hint);
+	}
+	
+	
+	inline
+	context_id_type
+	add_context(
+		context_id_type parent_id,
+		std::vector<worker::parameters> worker_parameters,
+		const context::parameters &context_parameters,
+		bool enabled = true
+	)
+	{
+		return this->add_context_(parent_id, std::move(worker_parameters), context_parameters, enabled, boost::none);
+	}
+	
+	
+	// Retires context: removes it from workers poll lists, stops and joins its own workers and stops its io_context.
+	// Tasks left in the context are not executed, so drain it first. Only contexts without active (not retired)
+	// children can be retired, root context can't be retired at all.
+	// NOTE: io_context of retired context lives until async_core destruction, so objects bound to it stay valid.
+	// NOTE: Don't call it from workers of the retired context itself.
+	void
+	retire_context(
+		context_id_type context_id
+	)
+	{
+		std::vector<std::thread> workers;
 		{
-			this->children_ptrs_.reserve(children_count);
-			this->workers_.reserve(this->worker_parameters_.size());
+			std::lock_guard<std::mutex> topology_lock{this->topology_mutex_};
+			node &n = this->nodes_.at(context_id);
+			if (n.retired_)
+				return;
+			if (context_id == 0)
+				throw std::invalid_argument{"Root context can't be retired"};
+			if (!n.children_ptrs_.empty())
+				throw std::invalid_argument{"Context has active children"};
+			for (const auto &worker: n.workers_)
+				if (worker.get_id() == std::this_thread::get_id())
+					throw std::logic_error{"Context can't be retired by its own worker"};
+			
+			n.retired_.store(true, std::memory_order_release);
+			auto &sibling_ptrs = this->nodes_[n.parent_id_].children_ptrs_;
+			sibling_ptrs.erase(std::remove(sibling_ptrs.begin(), sibling_ptrs.end(), &n), sibling_ptrs.end());
+			
+			workers.swap(n.workers_);
+			n.work_guard_ = boost::none;
+			n.io_context_.stop();
+			this->topology_changed_(n);
+		}
+		
+		for (auto &worker: workers)
+			worker.join();
+	}
+	
+	
+	// Posts handler to the context respecting its bounded queue (see context::parameters). Handler is executed
+	// by workers of the context, as any task posted to io_context directly.
+	// Throws context_overflow, if task is rejected (or the core is stopping, while poster is blocked), and
+	// std::invalid_argument, if the context is retired. Overflow contexts, which are retired, reject tasks.
+	template<class Handler>
+	void
+	post(
+		context_id_type context_id,
+		Handler &&handler
+	)
+	{
+		node &n = this->nodes_.at(context_id);
+		if (n.retired_.load(std::memory_order_acquire))	// Its io_context is stopped, task would be lost
+			throw std::invalid_argument{"Context is retired"};
+		if (n.context_parameters_.capacity == 0) {	// Unbounded
+			boost::asio::post(n.io_context_, std::forward<Handler>(handler));
+			return;
 		}
 		
+		std::unique_ptr<task_> task_ptr = task_::make(std::forward<Handler>(handler));
+		if (!this->post_task_(n, task_ptr, true, true))
+			throw context_overflow{};
+	}
+	
+	
+	// Same as post(), but never blocks and returns false instead of throwing.
+	template<class Handler>
+	bool
+	try_post(
+		context_id_type context_id,
+		Handler &&handler
+	)
+	{
+		node &n = this->nodes_.at(context_id);
+		if (n.context_parameters_.capacity == 0) {	// Unbounded
+			if (n.retired_.load(std::memory_order_acquire))
+				return false;
+			boost::asio::post(n.io_context_, std::forward<Handler>(handler));
+			return true;
+		}
 		
+		std::unique_ptr<task_> task_ptr = task_::make(std::forward<Handler>(handler));
+		return this->post_task_(n, task_ptr, false, true);
+	}
+	
+	
+	// Returns statistics collected by workers, if context is scheduled (see context::parameters), zeroes otherwise,
+	// and bounded queue statistics.
+	inline
+	context::statistics
+	get_context_statistics(
+		context_id_type context_id
+	) const
+	{
+		const node &n = this->nodes_.at(context_id);
+		
+		context::statistics statistics;
+		statistics.handlers_executed = n.handlers_executed_.load(std::memory_order_relaxed);
+		statistics.execution_time    = std::chrono::nanoseconds{n.execution_time_.load(std::memory_order_relaxed)};
+		statistics.deficit           = std::chrono::nanoseconds{n.deficit_.load(std::memory_order_relaxed)};
+		statistics.queue_size        = n.queue_size_.load(std::memory_order_relaxed);
+		statistics.tasks_rejected    = n.tasks_rejected_.load(std::memory_order_relaxed);
+		statistics.tasks_dropped     = n.tasks_dropped_.load(std::memory_order_relaxed);
+		statistics.tasks_redirected  = n.tasks_redirected_.load(std::memory_order_relaxed);
+		return statistics;
+	}
+	
+	
+	// Returns statistics of workers of the context (see worker::statistics). Workers publish their counters
+	// every 1024 rounds, at delays not more often than every 100 ms and when they leave their loops, so values
+	// are exact after stop() only.
+	inline
+	worker::statistics
+	get_worker_statistics(
+		context_id_type context_id
+	) const
+	{
+		const node &n = this->nodes_.at(context_id);
+		
+		worker::statistics statistics;
+		statistics.rounds            = n.worker_rounds_.load(std::memory_order_relaxed);
+		statistics.idle_rounds       = n.worker_idle_rounds_.load(std::memory_order_relaxed);
+		statistics.delays            = n.worker_delays_.load(std::memory_order_relaxed);
+		statistics.handlers_executed = n.worker_handlers_executed_.load(std::memory_order_relaxed);
+		return statistics;
+	}
+private:
+	static constexpr std::size_t queue_batch_size_ = 16;	// Queued tasks run by one pump
+	
+	
+	using task_ = detail::function_node<void()>;	// Task of bounded queue
+	
+	
+	
+	struct node
+	{
 		inline
 		node(
-			std::size_t children_count,
-			const std::vector<worker::parameters> &worker_parameters,
+			context_id_type id,
+			context_id_type parent_id,
+			std::vector<worker::parameters> worker_parameters,
+			const context::parameters &context_parameters,
 			bool enabled,
-			int concurrency_hint
+			boost::optional<int> concurrency_hint
 		):
-			io_context_{concurrency_hint},
-			worker_parameters_{worker_parameters},
+			concurrency_hint_{(concurrency_hint)? concurrency_hint.get(): BOOST_ASIO_CONCURRENCY_HINT_DEFAULT},
+			io_context_{this->concurrency_hint_},
+			worker_parameters_{std::move(worker_parameters)},
+			deficit_{context_parameters.quantum.count()},
+			context_parameters_(context_parameters),
+			handlers_interval_{
+				(context_parameters.handlers_per_second > 0)
+				? static_cast<std::chrono::nanoseconds::rep>(1e9 / context_parameters.handlers_per_second)
+				: 0
+			},
+			handlers_tolerance_{
+				this->handlers_interval_
+				* static_cast<std::chrono::nanoseconds::rep>(context_parameters.handlers_burst - 1)
+			},
+			cpu_factor_{(context_parameters.cpu_share > 0)? 1 / context_parameters.cpu_share: 0},
+			cpu_tolerance_{
+				static_cast<std::chrono::nanoseconds::rep>(
+					context_parameters.cpu_burst.count() * std::max(this->cpu_factor_ - 1, 0.)
+				)
+			},
+			id_{id},
+			parent_id_{parent_id},
+			scheduled_{
+				context_parameters.quantum.count() > 0 || context_parameters.accounting
+				|| this->handlers_interval_ > 0 || this->cpu_factor_ > 0
+			},
 			enabled_{(enabled)? true: false}
 		{
-			this->children_ptrs_.reserve(children_count);
 			this->workers_.reserve(this->worker_parameters_.size());
 		}
 		
 		
 		
+		const int concurrency_hint_;
 		boost::asio::io_context io_context_;
 		std::vector<node *> children_ptrs_;
 		std::vector<std::thread> workers_;
 		boost::optional<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>> work_guard_;
 		std::vector<worker::parameters> worker_parameters_;
-		bool enabled_;
+		
+		// Topology: version of contexts, which workers of this context run (changed by adding and retiring of
+		// descendants), and contexts, which own workers run in worker_run_single_() (they may block in them).
+		// Single runs are protected by topology lock.
+		std::atomic<std::size_t> topology_version_{0};
+		std::vector<std::pair<std::thread::id, node *>> single_runs_;
+		
+		// Statistics of own workers (see worker::statistics)
+		std::atomic<std::size_t> worker_rounds_{0}, worker_idle_rounds_{0}, worker_delays_{0};
+		std::atomic<std::size_t> worker_handlers_executed_{0};
+		
+		// Scheduling: Deficit Round-Robin and statistics (see context::parameters)
+		std::atomic<std::size_t> handlers_executed_{0};
+		std::atomic<std::chrono::nanoseconds::rep> execution_time_{0}, deficit_;
+		std::atomic<std::size_t> pollers_{0}, skips_{0};	// Workers polling the context, their skips in the round
+		const context::parameters context_parameters_;
+		
+		// Rate limits: Generic Cell Rate Algorithm. Context is allowed to run, if theoretical arrival time is not
+		// later than now + tolerance; each executed task (or nanosecond) pushes it forward.
+		std::atomic<std::chrono::nanoseconds::rep> handlers_tat_{0}, cpu_tat_{0};
+		const std::chrono::nanoseconds::rep handlers_interval_, handlers_tolerance_;
+		const double cpu_factor_;	// 1 / cpu_share
+		const std::chrono::nanoseconds::rep cpu_tolerance_;
+		
+		// Bounded queue: "pump" tasks in io_context run the oldest queued tasks, up to queue_batch_size_ each, then
+		// pass the rest to a new pump. New pumps are posted only when existing ones don't cover the queue, so several
+		// workers still may run queued tasks in parallel.
+		std::mutex queue_mutex_;
+		std::condition_variable queue_condition_;	// Blocked posters wait here
+		std::deque<std::unique_ptr<task_>> queue_;
+		std::size_t pumps_ = 0;	// Posted and not finished yet, protected by queue_mutex_
+		std::atomic<std::size_t> queue_size_{0}, tasks_rejected_{0}, tasks_dropped_{0}, tasks_redirected_{0};
+		
+		const context_id_type id_, parent_id_;
+		const bool scheduled_;	// Polled with time accounting
+		const bool enabled_;
+		std::atomic<bool> retired_{false};	// Changed under topology lock, but read by posters without it
 	};	// struct node
 	
 	
 	
+	// Growable array of nodes with stable addresses. Nodes are stored in segments, each next segment is twice
+	// larger than previous one. Appending requires external synchronization, but reading existing nodes doesn't.
 	class node_array
 	{
 	public:
@@ -440,7 +969,7 @@ private:
 		class iterator
 		{
 		public:
-			using iterator_category = std::random_access_iterator_tag;
+			using iterator_category = std::forward_iterator_tag;
 			
 			
 			iterator(
@@ -458,7 +987,7 @@ private:
 			async_core::node &
 			operator*() const noexcept
 			{
-				return *this->operator->();
+				return (*this->array_ptr_)[this->index_];
 			}
 			
 			
@@ -466,7 +995,7 @@ private:
 			async_core::node *
 			operator->() const noexcept
 			{
-				return reinterpret_cast<async_core::node *>(this->ptr_);
+				return &**this;
 			}
 			
 			
@@ -474,7 +1003,7 @@ private:
 			iterator &
 			operator++() noexcept
 			{
-				++this->ptr_;
+				++this->index_;
 				return *this;
 			}
 			
@@ -486,54 +1015,11 @@ private:
 			) noexcept
 			{
 				auto tmp = *this;
-				++this->ptr_;
-				return tmp;
-			}
-			
-			
-			inline
-			iterator &
-			operator--() noexcept
-			{
-				--this->ptr_;
-				return *this;
-			}
-			
-			
-			inline
-			iterator
-			operator--(
-				int
-			) noexcept
-			{
-				auto tmp = *this;
-				--this->ptr_;
+				++this->index_;
 				return tmp;
 			}
 			
 			
-			inline
-			iterator &
-			operator+=(
-				std::size_t n
-			) noexcept
-			{
-				this->ptr_ += n;
-				return *this;
-			}
-			
-			
-			inline
-			iterator &
-			operator-=(
-				std::size_t n
-			) noexcept
-			{
-				this->ptr_ += n;
-				return *this;
-			}
-			
-			
 			friend inline
 			bool
 			operator==(
@@ -541,7 +1027,7 @@ private:
 				const iterator &b
 			) noexcept
 			{
-				return a.ptr_ == b.ptr_;
+				return a.index_ == b.index_;
 			}
 			
 			
@@ -552,111 +1038,59 @@ private:
 				const iterator &b
 			) noexcept
 			{
-				return a.ptr_ != b.ptr_;
+				return a.index_ != b.index_;
 			}
-			
-			
-			friend inline
-			bool
-			operator<(
-				const iterator &a,
-				const iterator &b
-			) noexcept
-			{
-				return a.ptr_ < b.ptr_;
-			}
-			
-			
-			friend inline
-			bool
-			operator<=(
-				const iterator &a,
-				const iterator &b
-			) noexcept
-			{
-				return a.ptr_ <= b.ptr_;
-			}
-			
-			
-			friend inline
-			bool
-			operator>(
-				const iterator &a,
-				const iterator &b
-			) noexcept
-			{
-				return a.ptr_ > b.ptr_;
-			}
-			
-			
-			friend inline
-			bool
-			operator>=(
-				const iterator &a,
-				const iterator &b
-			) noexcept
-			{
-				return a.ptr_ >= b.ptr_;
-			}
-		private:
-			friend class node_array;
+		private:
+			friend class node_array;
 			
 			
 			inline
 			iterator(
-				node_storage_type *ptr
+				node_array *array_ptr,
+				std::size_t index
 			) noexcept:
-				ptr_{ptr}
+				array_ptr_{array_ptr},
+				index_{index}
 			{}
 			
 			
 			
-			node_storage_type *ptr_;
+			node_array *array_ptr_;
+			std::size_t index_;
 		};	// class iterator
 		
 		
 		
+		explicit
 		node_array(
-			const context_tree &t
-		):
-			nodes_ptr_{(t.nodes_.size() > 0)? new node_storage_type[t.nodes_.size()]: nullptr},
-			size_{t.nodes_.size()}
+			std::size_t first_segment_size
+		) noexcept:
+			first_segment_size_{(first_segment_size > 0)? first_segment_size: 1}
 		{
-			std::size_t nodes_initialized = 0;
-			
-			try {
-				for (const auto &n: t.nodes_) {
-					if (static_cast<bool>(n.concurrency_hint_)) {
-						new(&(*this)[nodes_initialized]) node{
-							n.children_count_,
-							n.worker_parameters_,
-							n.enabled_,
-							n.concurrency_hint_.get()
-						};
-					} else {
-						new(&(*this)[nodes_initialized]) node{
-							n.children_count_,
-							n.worker_parameters_,
-							n.enabled_
-						};
-					}
-					++nodes_initialized;
-					
-					const std::size_t current_id = nodes_initialized - 1;
-					if (n.parent_id_ != current_id)
-						this->at(n.parent_id_).children_ptrs_.push_back(&(*this)[current_id]);
-				}
-			} catch (...) {
-				this->delete_nodes_(nodes_initialized);
-				throw;
-			}
+			for (auto &segment_ptr: this->segment_ptrs_)
+				segment_ptr = nullptr;
 		}
 		
 		
+		node_array(
+			const node_array &other
+		) = delete;
+		
+		
+		node_array &
+		operator=(
+			const node_array &other
+		) = delete;
+		
+		
 		inline
 		~node_array()
 		{
-			this->delete_nodes_(this->size_);
+			for (std::size_t i = this->size(); i > 0; --i)
+				(*this)[i - 1].~node();
+			
+			for (auto segment_ptr: this->segment_ptrs_)
+				delete [] segment_ptr;
 		}
 		
 		
@@ -664,7 +1098,7 @@ private:
 		std::size_t
 		size() const noexcept
 		{
-			return this->size_;
+			return this->size_.load(std::memory_order_acquire);
 		}
 		
 		
@@ -672,7 +1106,7 @@ private:
 		bool
 		empty() const noexcept
 		{
-			return this->size_ == 0;
+			return this->size() == 0;
 		}
 		
 		
@@ -682,7 +1116,8 @@ private:
 			std::size_t i
 		) noexcept
 		{
-			return *reinterpret_cast<node *>(this->nodes_ptr_ + i);
+			const auto location = this->locate_(i);
+			return *reinterpret_cast<node *>(this->segment_ptrs_[location.first] + location.second);
 		}
 		
 		
@@ -692,7 +1127,8 @@ private:
 			std::size_t i
 		) const noexcept
 		{
-			return *reinterpret_cast<node *>(this->nodes_ptr_ + i);
+			const auto location = this->locate_(i);
+			return *reinterpret_cast<const node *>(this->segment_ptrs_[location.first] + location.second);
 		}
 		
 		
@@ -702,7 +1138,7 @@ private:
 			std::size_t i
 		)
 		{
-			if (i < this->size_)
+			if (i < this->size())
 				return (*this)[i];
 			throw std::out_of_range{"Incorrect context id"};
 		}
@@ -714,7 +1150,7 @@ private:
 			std::size_t i
 		) const
 		{
-			if (i < this->size_)
+			if (i < this->size())
 				return (*this)[i];
 			throw std::out_of_range{"Incorrect context id"};
 		}
@@ -729,56 +1165,76 @@ private:
 		
 		
 		inline
-		std::size_t
-		index_of(
-			const node &n
-		) const noexcept
+		iterator
+		begin() noexcept
 		{
-			return static_cast<std::size_t>(reinterpret_cast<const node_storage_type *>(&n) - this->nodes_ptr_);
+			return {this, 0};
 		}
 		
 		
 		inline
 		iterator
-		begin() noexcept
+		end() noexcept
 		{
-			return this->nodes_ptr_;
+			return {this, this->size()};
 		}
 		
 		
-		inline
-		iterator
-		end() noexcept
+		// Requires external synchronization with other emplace_back() calls.
+		template<class... Args>
+		node &
+		emplace_back(
+			Args &&... args
+		)
 		{
-			return this->nodes_ptr_ + this->size_;
+			const std::size_t i = this->size_.load(std::memory_order_relaxed);
+			const auto location = this->locate_(i);
+			
+			node_storage_type *&segment_ptr = this->segment_ptrs_[location.first];
+			if (segment_ptr == nullptr)
+				segment_ptr = new node_storage_type[this->first_segment_size_ << location.first];
+			
+			node *node_ptr = new(segment_ptr + location.second) node{std::forward<Args>(args)...};
+			this->size_.store(i + 1, std::memory_order_release);
+			return *node_ptr;
 		}
 	private:
-		void
-		delete_nodes_(
-			std::size_t nodes_initialized
-		) noexcept
+		static constexpr std::size_t max_segments = std::numeric_limits<std::size_t>::digits;
+		
+		
+		
+		// Returns segment index and offset in the segment.
+		inline
+		std::pair<std::size_t, std::size_t>
+		locate_(
+			std::size_t i
+		) const noexcept
 		{
-			if (nodes_initialized > 0) {
-				do {
-					--nodes_initialized;
-					(*this)[nodes_initialized].~node();
-					::operator delete(&(*this)[nodes_initialized], &(*this)[nodes_initialized]);
-				} while (nodes_initialized > 0);
+			std::size_t segment = 0, segment_size = this->first_segment_size_;
+			while (i >= segment_size) {
+				i -= segment_size;
+				segment_size <<= 1;
+				++segment;
 			}
-			
-			if (this->nodes_ptr_ != nullptr)
-				delete [] this->nodes_ptr_;
+			return {segment, i};
 		}
 		
 		
 		
-		node_storage_type * const nodes_ptr_;
-		const std::size_t size_;
+		node_storage_type *segment_ptrs_[max_segments];
+		std::atomic<std::size_t> size_{0};
+		const std::size_t first_segment_size_;
 	};	// class node_array
 	
 	
 	
-	using poll_method_type = std::size_t (boost::asio::io_context::*)();
+	// Worker loops are instantiated for every combination of poll and delay policies, so policies are resolved
+	// at compile time and polling functions are inlined into the loop.
+	template<worker::poll PollPolicy>
+	using poll_tag_ = std::integral_constant<worker::poll, PollPolicy>;
+	
+	template<worker::delay DelayPolicy>
+	using delay_tag_ = std::integral_constant<worker::delay, DelayPolicy>;
 	
 	
 	
@@ -840,43 +1296,239 @@ private:
 	}
 	
 	
+	// Core posts to contexts and stops them from any thread, so scheduler of io_context should be locked.
 	static inline
-	poll_method_type
-	worker_get_poll_method_(
-		worker::poll poll_policy
+	void
+	check_concurrency_hint_(
+		int concurrency_hint
+	)
+	{
+		if (!BOOST_ASIO_CONCURRENCY_HINT_IS_LOCKING(SCHEDULER, concurrency_hint))
+			throw std::invalid_argument{"Concurrency hint should not disable scheduler locking"};
+	}
+	
+	
+	static
+	context::parameters
+	fixed_context_parameters_(
+		context::parameters parameters
 	) noexcept
 	{
-		switch (poll_policy) {
-			case worker::poll::disabled:
-				return nullptr;
-			case worker::poll::poll_one:
-				return &boost::asio::io_context::poll_one;
-			case worker::poll::poll_all:
-				return &boost::asio::io_context::poll;
-			case worker::poll::run_one:
-				return &boost::asio::io_context::run_one;
+		const context::parameters default_parameters{};
+		
+		// Deficit Round-Robin
+		if (parameters.quantum < std::chrono::nanoseconds::zero())
+			parameters.quantum = std::chrono::nanoseconds::zero();
+		
+		
+		// Rate limits
+		if (!(parameters.handlers_per_second > 0))	// NaN too
+			parameters.handlers_per_second = 0;
+		else if (parameters.handlers_per_second < 1e-9)	// Interval overflow
+			parameters.handlers_per_second = 1e-9;
+		if (parameters.handlers_burst < 1)
+			parameters.handlers_burst = default_parameters.handlers_burst;
+		
+		if (!(parameters.cpu_share > 0) || parameters.cpu_share >= 1)	// NaN too
+			parameters.cpu_share = 0;
+		else if (parameters.cpu_share < 1e-6)
+			parameters.cpu_share = 1e-6;
+		if (parameters.cpu_burst < std::chrono::nanoseconds::zero())
+			parameters.cpu_burst = std::chrono::nanoseconds::zero();
+		
+		
+		// Bounded queue
+		switch (parameters.overflow_policy) {
+			case context::overflow::reject:
+				break;
+			case context::overflow::drop_oldest:
+				break;
+			case context::overflow::block:
+				break;
+			case context::overflow::redirect:
+				break;
+			default:
+				parameters.overflow_policy = default_parameters.overflow_policy;
+				break;
 		}
-		return nullptr;
+		
+		return parameters;
 	}
 	
 	
 	void
-	start_workers_()
+	add_nodes_(
+		const context_tree &t
+	)
 	{
-		if (this->nodes_.empty())
-			return;
+		const std::vector<std::size_t> runners_counts = t.runners_counts_();
 		
-		std::vector<node *> ordered_node_ptrs = this->order_nodes_();
-		for (auto it = ordered_node_ptrs.rbegin(), end = ordered_node_ptrs.rend(); it < end; ++it) {
-			auto &n = **it;
-			n.work_guard_.emplace(boost::asio::make_work_guard(n.io_context_));
+		std::size_t i = 0;
+		for (const auto &n: t.nodes_) {
+			boost::optional<int> concurrency_hint = n.concurrency_hint_;
+			if (!concurrency_hint && runners_counts[i] == 1)
+				concurrency_hint = this->single_worker_concurrency_hint_;
+			
+			this->add_node_(n.parent_id_, n.worker_parameters_, n.context_parameters_, n.enabled_, concurrency_hint);
+			++i;
+		}
+	}
+	
+	
+	context_id_type
+	add_context_(
+		context_id_type parent_id,
+		std::vector<worker::parameters> worker_parameters,
+		const context::parameters &context_parameters,
+		bool enabled,
+		boost::optional<int> concurrency_hint
+	)
+	{
+		for (auto &parameters: worker_parameters)
+			parameters = async_core::fixed_worker_parameters_(parameters);
+		
+		std::lock_guard<std::mutex> topology_lock{this->topology_mutex_};
+		
+		const context_id_type new_id = this->nodes_.size();
+		if (parent_id >= new_id && parent_id != 0)
+			throw std::out_of_range{"Incorrect context parent id"};
+		if (new_id != 0 && this->nodes_[parent_id].retired_)
+			throw std::invalid_argument{"Parent context is retired"};
+		
+		if (!concurrency_hint && this->runners_count_(parent_id, worker_parameters, enabled, new_id == 0) == 1)
+			concurrency_hint = this->single_worker_concurrency_hint_;
+		
+		node &n = this->add_node_(
+			parent_id,
+			std::move(worker_parameters),
+			async_core::fixed_context_parameters_(context_parameters),
+			enabled,
+			concurrency_hint
+		);
+		if (this->state_.load(std::memory_order_acquire) == state::running) {
+			this->start_node_workers_(n);
+			this->topology_changed_(this->nodes_[parent_id]);
+		}
+		
+		return new_id;
+	}
+	
+	
+	// Requires topology lock or exclusive access to the core.
+	node &
+	add_node_(
+		context_id_type parent_id,
+		std::vector<worker::parameters> worker_parameters,
+		const context::parameters &context_parameters,
+		bool enabled,
+		boost::optional<int> concurrency_hint
+	)
+	{
+		const context_id_type new_id = this->nodes_.size();
+		
+		std::vector<node *> *sibling_ptrs_ptr = nullptr;
+		if (new_id != parent_id) {	// Reserve before emplacing: no exceptions after new node appears
+			sibling_ptrs_ptr = &this->nodes_[parent_id].children_ptrs_;
+			if (sibling_ptrs_ptr->size() == sibling_ptrs_ptr->capacity())
+				sibling_ptrs_ptr->reserve(2 * sibling_ptrs_ptr->size() + 1);
+		}
+		
+		node &n = this->nodes_.emplace_back(
+			new_id,
+			parent_id,
+			std::move(worker_parameters),
+			context_parameters,
+			enabled,
+			concurrency_hint
+		);
+		if (sibling_ptrs_ptr != nullptr)
+			sibling_ptrs_ptr->push_back(&n);
+		
+		return n;
+	}
+	
+	
+	// Same as context_tree::runners_counts_(), but for a new context of the running core.
+	std::size_t
+	runners_count_(
+		context_id_type parent_id,
+		const std::vector<worker::parameters> &worker_parameters,
+		bool enabled,
+		bool is_root
+	) const
+	{
+		if (!enabled)
+			return 0;
+		
+		std::size_t runners_count = 0;
+		for (const worker::parameters &parameters: worker_parameters)
+			if (parameters.self_poll_policy != worker::poll::disabled)
+				++runners_count;
+		
+		if (!is_root) {
+			context_id_type ancestor_id = parent_id;
+			while (true) {
+				const node &ancestor = this->nodes_[ancestor_id];
+				for (const worker::parameters &parameters: ancestor.worker_parameters_)
+					if (parameters.children_poll_policy != worker::poll::disabled)
+						++runners_count;
+				
+				if (ancestor_id == ancestor.parent_id_)
+					break;
+				ancestor_id = ancestor.parent_id_;
+			}
+		}
+		
+		return runners_count;
+	}
+	
+	
+	// Requires topology lock. Makes workers of the changed context and its ancestors (they may run its descendants)
+	// replan their poll lists. Workers of other contexts are not affected.
+	void
+	topology_changed_(
+		node &changed_node
+	)
+	{
+		for (node *node_ptr = &changed_node; ; node_ptr = &this->nodes_[node_ptr->parent_id_]) {
+			node_ptr->topology_version_.fetch_add(1);
 			
-			for (const worker::parameters &parameters: n.worker_parameters_)
-				n.workers_.emplace_back(&async_core::worker_run_, this, std::ref(n), std::cref(parameters));
+			// Workers running single context may block in it, wake them up
+			for (const auto &single_run: node_ptr->single_runs_)
+				this->worker_post_wakeup_(*node_ptr, *single_run.second, single_run.first);
+			
+			if (node_ptr->id_ == 0)
+				break;
 		}
+		
+		this->topology_condition_.notify_all();
+	}
+	
+	
+	// Requires topology lock.
+	void
+	start_workers_()
+	{
+		std::vector<node *> ordered_node_ptrs = this->order_nodes_();
+		for (auto it = ordered_node_ptrs.rbegin(), end = ordered_node_ptrs.rend(); it < end; ++it)
+			this->start_node_workers_(**it);
 	}
 	
 	
+	// Requires topology lock.
+	void
+	start_node_workers_(
+		node &n
+	)
+	{
+		n.work_guard_.emplace(boost::asio::make_work_guard(n.io_context_));
+		
+		for (const worker::parameters &parameters: n.worker_parameters_)
+			n.workers_.emplace_back(&async_core::worker_run_, this, std::ref(n), std::cref(parameters));
+	}
+	
+	
+	// Requires topology lock. Returns active contexts in BFS order from the root.
 	std::vector<node *>
 	order_nodes_()
 	{
@@ -884,20 +1536,9 @@ private:
 		ordered_node_ptrs.reserve(this->nodes_.size());
 		ordered_node_ptrs.push_back(&this->nodes_.front());
 		
-		std::vector<bool> visited(this->nodes_.size(), false);
-		visited[0] = true;
-		
-		auto ordered_it = ordered_node_ptrs.begin();
-		while (ordered_node_ptrs.size() < this->nodes_.size()) {
-			for (auto child_ptr: (*ordered_it)->children_ptrs_) {
-				const auto child_id = this->nodes_.index_of(*child_ptr);
-				if (!visited[child_id]) {
-					visited[child_id] = true;
-					ordered_node_ptrs.push_back(child_ptr);
-				}
-			}
-			++ordered_it;
-		}
+		for (std::size_t i = 0; i < ordered_node_ptrs.size(); ++i)
+			for (auto child_ptr: ordered_node_ptrs[i]->children_ptrs_)
+				ordered_node_ptrs.push_back(child_ptr);
 		
 		return ordered_node_ptrs;
 	}
@@ -906,10 +1547,153 @@ private:
 	void
 	stop_workers_()
 	{
+		std::lock_guard<std::mutex> topology_lock{this->topology_mutex_};
 		for (auto &n: this->nodes_)
 			n.work_guard_ = boost::none;
 		for (auto &n: this->nodes_)
 			n.io_context_.stop();
+		this->topology_condition_.notify_all();
+		
+		for (auto &n: this->nodes_) {	// Wake up blocked posters
+			{
+				std::lock_guard<std::mutex> queue_lock{n.queue_mutex_};
+			}
+			n.queue_condition_.notify_all();
+		}
+	}
+	
+	
+	// Returns false, if task is rejected (task_ptr is not moved then).
+	bool
+	post_task_(
+		node &n,
+		std::unique_ptr<task_> &task_ptr,
+		bool may_block,
+		bool may_redirect
+	)
+	{
+		const context::parameters &parameters = n.context_parameters_;
+		
+		if (n.retired_.load(std::memory_order_acquire)) {	// Retired overflow context or bounded context itself
+			n.tasks_rejected_.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		
+		if (parameters.capacity == 0) {	// Unbounded overflow context
+			boost::asio::post(n.io_context_, [task_ptr = std::move(task_ptr)] { (*task_ptr)(); });
+			return true;
+		}
+		
+		std::unique_ptr<task_> dropped_task_ptr;	// Destroyed without lock
+		{
+			std::unique_lock<std::mutex> queue_lock{n.queue_mutex_};
+			if (n.queue_.size() >= parameters.capacity) {
+				switch (parameters.overflow_policy) {
+					case context::overflow::reject:
+						n.tasks_rejected_.fetch_add(1, std::memory_order_relaxed);
+						return false;
+					case context::overflow::drop_oldest:
+						dropped_task_ptr = std::move(n.queue_.front());
+						n.queue_.pop_front();
+						n.tasks_dropped_.fetch_add(1, std::memory_order_relaxed);
+						break;
+					case context::overflow::block:
+						if (may_block)
+							n.queue_condition_.wait(
+								queue_lock,
+								[&]() noexcept -> bool
+								{
+									return
+										n.queue_.size() < parameters.capacity
+										|| this->state_.load(std::memory_order_relaxed) == state::stopping;
+								}
+							);
+						if (n.queue_.size() >= parameters.capacity) {
+							n.tasks_rejected_.fetch_add(1, std::memory_order_relaxed);
+							return false;
+						}
+						break;
+					case context::overflow::redirect:
+						queue_lock.unlock();
+						if (
+							may_redirect
+							&& parameters.overflow_context_id != n.id_
+							&& parameters.overflow_context_id < this->nodes_.size()
+							&& this->post_task_(this->nodes_[parameters.overflow_context_id], task_ptr, false, false)
+						) {
+							n.tasks_redirected_.fetch_add(1, std::memory_order_relaxed);
+							return true;
+						}
+						n.tasks_rejected_.fetch_add(1, std::memory_order_relaxed);
+						return false;
+				}
+			}
+			
+			n.queue_.push_back(std::move(task_ptr));
+			n.queue_size_.store(n.queue_.size(), std::memory_order_relaxed);
+			async_core::post_pump_if_needed_(n);
+		}
+		
+		return true;
+	}
+	
+	
+	// Posts new pump, if existing ones don't cover the queue. Requires queue lock.
+	static
+	void
+	post_pump_if_needed_(
+		node &n
+	)
+	{
+		if (n.pumps_ * async_core::queue_batch_size_ < n.queue_.size()) {
+			node *node_ptr = &n;
+			boost::asio::post(n.io_context_, [node_ptr] { async_core::run_queued_tasks_(*node_ptr); });
+			++n.pumps_;
+		}
+	}
+	
+	
+	// Pump: runs up to queue_batch_size_ oldest queued tasks, then lets other handlers run and passes the rest
+	// to a new pump. Queue lock is not held while task is running, so drop_oldest and posters are not delayed.
+	static
+	void
+	run_queued_tasks_(
+		node &n
+	)
+	{
+		const auto finish_pump =
+			[&n]
+			{
+				std::lock_guard<std::mutex> queue_lock{n.queue_mutex_};
+				--n.pumps_;
+				async_core::post_pump_if_needed_(n);
+			};
+		
+		for (std::size_t i = 0; i < async_core::queue_batch_size_; ++i) {
+			std::unique_ptr<task_> task_ptr;
+			{
+				std::lock_guard<std::mutex> queue_lock{n.queue_mutex_};
+				if (n.queue_.empty()) {	// Tasks were dropped or run by other pumps
+					--n.pumps_;
+					return;
+				}
+				
+				task_ptr = std::move(n.queue_.front());
+				n.queue_.pop_front();
+				n.queue_size_.store(n.queue_.size(), std::memory_order_relaxed);
+			}
+			
+			if (n.context_parameters_.overflow_policy == context::overflow::block)
+				n.queue_condition_.notify_one();
+			try {
+				(*task_ptr)();
+			} catch (...) {	// Exception leaves io_context::run(), but the rest of the queue still must be run
+				finish_pump();
+				throw;
+			}
+		}
+		
+		finish_pump();
 	}
 	
 	
@@ -918,10 +1702,17 @@ private:
 	{
 		if (!this->joined_.exchange(true)) {	// Not joined before
 			std::lock_guard<std::mutex> join_lock{this->join_mutex_};
-			for (auto &n: this->nodes_) {
-				for (auto &worker: n.workers_)
+			for (std::size_t i = 0; ; ++i) {	// Contexts may be added concurrently
+				std::vector<std::thread> workers;
+				{
+					std::lock_guard<std::mutex> topology_lock{this->topology_mutex_};
+					if (i >= this->nodes_.size())
+						break;
+					workers.swap(this->nodes_[i].workers_);
+				}
+				
+				for (auto &worker: workers)
 					worker.join();
-				n.workers_.clear();
 			}
 			this->joined_.store(false, std::memory_order_release);
 			this->state_.store(state::idle, std::memory_order_release);
@@ -931,35 +1722,158 @@ private:
 	}
 	
 	
+	// Worker loop counters. Kept by the worker locally and published to its node in batches, so workers don't
+	// contend on shared counters every round. Disabled counters do nothing (see worker::parameters::statistics).
+	struct worker_counters_
+	{
+		static constexpr std::size_t publish_rounds = 1024;
+		static constexpr std::chrono::milliseconds::rep publish_interval_ms = 100;	// For delays
+		
+		
+		explicit
+		worker_counters_(
+			bool enabled
+		) noexcept:
+			enabled{enabled}
+		{}
+		
+		
+		inline
+		void
+		add_round(
+			node &worker_node,
+			std::size_t executed
+		) noexcept
+		{
+			if (!this->enabled)
+				return;
+			
+			++this->statistics.rounds;
+			this->statistics.handlers_executed += executed;
+			if (executed == 0)
+				++this->statistics.idle_rounds;
+			if (this->statistics.rounds >= worker_counters_::publish_rounds)
+				this->publish(worker_node);
+		}
+		
+		
+		// Delays may be frequent (e.g. yields), so they are published by time.
+		inline
+		void
+		add_delay(
+			node &worker_node
+		) noexcept
+		{
+			if (!this->enabled)
+				return;
+			
+			++this->statistics.delays;
+			if (
+				std::chrono::steady_clock::now() - this->published_time
+				>= std::chrono::milliseconds{worker_counters_::publish_interval_ms}
+			)
+				this->publish(worker_node);
+		}
+		
+		
+		inline
+		void
+		publish(
+			node &worker_node
+		) noexcept
+		{
+			if (!this->enabled)
+				return;
+			
+			worker_node.worker_rounds_.fetch_add(this->statistics.rounds, std::memory_order_relaxed);
+			worker_node.worker_idle_rounds_.fetch_add(this->statistics.idle_rounds, std::memory_order_relaxed);
+			worker_node.worker_delays_.fetch_add(this->statistics.delays, std::memory_order_relaxed);
+			worker_node.worker_handlers_executed_.fetch_add(
+				this->statistics.handlers_executed,
+				std::memory_order_relaxed
+			);
+			this->statistics = worker::statistics{};
+			this->published_time = std::chrono::steady_clock::now();
+		}
+		
+		
+		
+		const bool enabled;
+		worker::statistics statistics;
+		std::chrono::steady_clock::time_point published_time = std::chrono::steady_clock::now();
+	};	// struct worker_counters_
+	
+	
+	// Plans contexts to run and runs them until stop or topology change.
 	void
 	worker_run_(
 		node &n,
 		const worker::parameters &parameters
-	) const
+	)
 	{
-		boost::asio::io_context *self_context_ptr =
-			(parameters.self_poll_policy != worker::poll::disabled && n.enabled_)? &n.io_context_: nullptr;
-		
-		std::vector<boost::asio::io_context *> child_context_ptrs =
-			worker_get_child_contexts_to_run_(n, parameters);
-		
-		if (child_context_ptrs.empty() && self_context_ptr != nullptr) {
-			return this->worker_run_single_(n, parameters, *self_context_ptr);
-		} else if (child_context_ptrs.size() == 1 && self_context_ptr == nullptr) {
-			return this->worker_run_single_(n, parameters, *child_context_ptrs.front());
-		} else if (child_context_ptrs.size() > 1 || self_context_ptr != nullptr) {
-			return this->worker_run_multiple_(n, parameters, self_context_ptr, std::move(child_context_ptrs));
+		while (!this->worker_stopping_()) {
+			std::size_t topology_version;
+			node *self_node_ptr, *single_node_ptr = nullptr;
+			std::vector<node *> child_node_ptrs;
+			
+			{
+				std::unique_lock<std::mutex> topology_lock{this->topology_mutex_};
+				if (n.retired_)
+					return;
+				
+				topology_version = n.topology_version_.load(std::memory_order_relaxed);
+				self_node_ptr = (parameters.self_poll_policy != worker::poll::disabled && n.enabled_)? &n: nullptr;
+				child_node_ptrs = this->worker_get_child_contexts_to_run_(n, parameters);
+				
+				if (child_node_ptrs.empty() && self_node_ptr == nullptr) {	// Nothing to run, wait for descendants
+					this->topology_condition_.wait(
+						topology_lock,
+						[&]() noexcept -> bool
+						{
+							return this->worker_stopping_() || !this->worker_topology_actual_(n, topology_version);
+						}
+					);
+					continue;
+				}
+				
+				// Scheduled contexts are polled only
+				if (child_node_ptrs.empty() && !self_node_ptr->scheduled_)
+					single_node_ptr = self_node_ptr;
+				else if (
+					child_node_ptrs.size() == 1 && self_node_ptr == nullptr && !child_node_ptrs.front()->scheduled_
+				)
+					single_node_ptr = child_node_ptrs.front();
+				
+				if (single_node_ptr != nullptr)	// Registered before run: wake ups can't be missed
+					n.single_runs_.emplace_back(std::this_thread::get_id(), single_node_ptr);
+			}
+			
+			if (single_node_ptr != nullptr) {
+				this->worker_run_single_(topology_version, parameters, n, *single_node_ptr);
+				
+				std::lock_guard<std::mutex> topology_lock{this->topology_mutex_};
+				n.single_runs_.erase(
+					std::find(
+						n.single_runs_.begin(),
+						n.single_runs_.end(),
+						std::make_pair(std::this_thread::get_id(), single_node_ptr)
+					)
+				);
+			} else {
+				this->worker_run_multiple_(topology_version, parameters, n, self_node_ptr, std::move(child_node_ptrs));
+			}
 		}
 	}
 	
 	
-	std::vector<boost::asio::io_context *>
+	// Requires topology lock.
+	std::vector<node *>
 	worker_get_child_contexts_to_run_(
 		node &n,
 		const worker::parameters &parameters
 	) const
 	{
-		std::vector<boost::asio::io_context *> child_context_ptrs;
+		std::vector<node *> child_node_ptrs;
 		
 		if (parameters.children_poll_policy != worker::poll::disabled) {
 			std::queue<node *> nodes_queue_;
@@ -972,100 +1886,508 @@ private:
 				nodes_queue_.pop();
 				
 				if (node_ptr->enabled_)
-					child_context_ptrs.push_back(&node_ptr->io_context_);
+					child_node_ptrs.push_back(node_ptr);
 				
 				for (node *child_ptr: node_ptr->children_ptrs_)
 					nodes_queue_.push(child_ptr);
 			}
-			child_context_ptrs.shrink_to_fit();
+			child_node_ptrs.shrink_to_fit();
 		}
 		
-		return child_context_ptrs;
+		return child_node_ptrs;
 	}
 	
 	
+	// Uses run_one() instead of run() to notice topology changes (see topology_changed_()). Core state and
+	// topology are checked only after wake ups and when io_context is stopped (stop() and retire_context() stop
+	// it), not after each handler.
 	void
 	worker_run_single_(
-		node &n,
+		std::size_t topology_version,
 		const worker::parameters &parameters,
-		boost::asio::io_context &context
+		node &worker_node,
+		node &context_node
 	) const
 	{
+		boost::asio::io_context &context = context_node.io_context_;
+		bool &woken_up = async_core::worker_woken_up_();
+		woken_up = false;
+		
+		worker_counters_ counters{parameters.statistics};
 		std::size_t wait_rounds = 0;
-		while (this->get_state() != state::stopping) {
-			if (wait_rounds >= parameters.delay_rounds) {
-				wait_rounds = 0;
-				this->worker_delay_(parameters);
+		while (this->worker_continue_(worker_node, topology_version)) {
+			try {
+				while (true) {
+					if (wait_rounds >= parameters.delay_rounds) {
+						wait_rounds = 0;
+						counters.add_delay(worker_node);
+						this->worker_delay_(parameters);
+					}
+					
+					const std::size_t executed = context.run_one();
+					counters.add_round(worker_node, executed);
+					if (executed == 0)	// Stopped
+						++wait_rounds;
+					else if (!woken_up)
+						continue;
+					
+					woken_up = false;
+					if (!this->worker_continue_(worker_node, topology_version))
+						break;
+				}
+			} catch (const std::exception &e) {
+				this->worker_handle_exception_(e);
 			}
-			
-			this->worker_poll_context_(context, &boost::asio::io_context::run);
-			if (context.stopped())
-				++wait_rounds;
 		}
+		counters.publish(worker_node);
 	}
 	
 	
+	// Selects worker loop instantiation: self poll policy -> children poll policy -> delay policy.
 	void
 	worker_run_multiple_(
-		node &n,
+		std::size_t topology_version,
 		const worker::parameters &parameters,
-		boost::asio::io_context *self_context_ptr,
-		std::vector<boost::asio::io_context *> child_context_ptrs
+		node &worker_node,
+		node *self_node_ptr,
+		std::vector<node *> child_node_ptrs
 	) const
 	{
-		const poll_method_type self_poll_method =
-			(self_context_ptr == nullptr)? nullptr: async_core::worker_get_poll_method_(parameters.self_poll_policy);
-		
-		const poll_method_type children_poll_method =
-			async_core::worker_get_poll_method_(parameters.children_poll_policy);
+		const worker::poll self_poll_policy =
+			(self_node_ptr == nullptr)? worker::poll::disabled: parameters.self_poll_policy;
+		
+		// Scheduled contexts count their pollers for Deficit Round-Robin rounds
+		std::vector<node *> scheduled_node_ptrs;
+		if (self_node_ptr != nullptr && self_node_ptr->scheduled_)
+			scheduled_node_ptrs.push_back(self_node_ptr);
+		for (node *child_ptr: child_node_ptrs)
+			if (child_ptr->scheduled_)
+				scheduled_node_ptrs.push_back(child_ptr);
+		for (node *node_ptr: scheduled_node_ptrs)
+			node_ptr->pollers_.fetch_add(1, std::memory_order_relaxed);
+		
+		switch (self_poll_policy) {
+			case worker::poll::disabled:
+				this->worker_run_multiple_(
+					poll_tag_<worker::poll::disabled>{},
+					topology_version, parameters, worker_node, self_node_ptr, std::move(child_node_ptrs)
+				);
+				break;
+			case worker::poll::poll_one:
+				this->worker_run_multiple_(
+					poll_tag_<worker::poll::poll_one>{},
+					topology_version, parameters, worker_node, self_node_ptr, std::move(child_node_ptrs)
+				);
+				break;
+			case worker::poll::poll_all:
+				this->worker_run_multiple_(
+					poll_tag_<worker::poll::poll_all>{},
+					topology_version, parameters, worker_node, self_node_ptr, std::move(child_node_ptrs)
+				);
+				break;
+			case worker::poll::run_one:
+				this->worker_run_multiple_(
+					poll_tag_<worker::poll::run_one>{},
+					topology_version, parameters, worker_node, self_node_ptr, std::move(child_node_ptrs)
+				);
+				break;
+		}
 		
-		std::size_t wait_rounds = 0;
-		while (this->get_state() != state::stopping) {
-			if (wait_rounds >= parameters.delay_rounds) {
-				wait_rounds = 0;
-				this->worker_delay_(parameters);
+		for (node *node_ptr: scheduled_node_ptrs)
+			node_ptr->pollers_.fetch_sub(1, std::memory_order_relaxed);
+	}
+	
+	
+	template<worker::poll SelfPollPolicy>
+	void
+	worker_run_multiple_(
+		poll_tag_<SelfPollPolicy> self_poll_tag,
+		std::size_t topology_version,
+		const worker::parameters &parameters,
+		node &worker_node,
+		node *self_node_ptr,
+		std::vector<node *> child_node_ptrs
+	) const
+	{
+		switch (parameters.children_poll_policy) {
+			case worker::poll::disabled:
+				return this->worker_run_multiple_(
+					self_poll_tag, poll_tag_<worker::poll::disabled>{},
+					topology_version, parameters, worker_node, self_node_ptr, std::move(child_node_ptrs)
+				);
+			case worker::poll::poll_one:
+				return this->worker_run_multiple_(
+					self_poll_tag, poll_tag_<worker::poll::poll_one>{},
+					topology_version, parameters, worker_node, self_node_ptr, std::move(child_node_ptrs)
+				);
+			case worker::poll::poll_all:
+				return this->worker_run_multiple_(
+					self_poll_tag, poll_tag_<worker::poll::poll_all>{},
+					topology_version, parameters, worker_node, self_node_ptr, std::move(child_node_ptrs)
+				);
+			case worker::poll::run_one:
+				return this->worker_run_multiple_(
+					self_poll_tag, poll_tag_<worker::poll::run_one>{},
+					topology_version, parameters, worker_node, self_node_ptr, std::move(child_node_ptrs)
+				);
+		}
+	}
+	
+	
+	template<worker::poll SelfPollPolicy, worker::poll ChildrenPollPolicy>
+	void
+	worker_run_multiple_(
+		poll_tag_<SelfPollPolicy> self_poll_tag,
+		poll_tag_<ChildrenPollPolicy> children_poll_tag,
+		std::size_t topology_version,
+		const worker::parameters &parameters,
+		node &worker_node,
+		node *self_node_ptr,
+		std::vector<node *> child_node_ptrs
+	) const
+	{
+		switch (parameters.delay_policy) {
+			case worker::delay::no_delay:
+				return this->worker_run_multiple_(
+					self_poll_tag, children_poll_tag, delay_tag_<worker::delay::no_delay>{},
+					topology_version, parameters, worker_node, self_node_ptr, std::move(child_node_ptrs)
+				);
+			case worker::delay::yield:
+				return this->worker_run_multiple_(
+					self_poll_tag, children_poll_tag, delay_tag_<worker::delay::yield>{},
+					topology_version, parameters, worker_node, self_node_ptr, std::move(child_node_ptrs)
+				);
+			case worker::delay::sleep:
+				return this->worker_run_multiple_(
+					self_poll_tag, children_poll_tag, delay_tag_<worker::delay::sleep>{},
+					topology_version, parameters, worker_node, self_node_ptr, std::move(child_node_ptrs)
+				);
+		}
+	}
+	
+	
+	// Worker loop itself. Exception handling is moved out of the round: after exception the round continues
+	// from the next context, so one throwing context can't starve the others.
+	template<worker::poll SelfPollPolicy, worker::poll ChildrenPollPolicy, worker::delay DelayPolicy>
+	void
+	worker_run_multiple_(
+		poll_tag_<SelfPollPolicy> self_poll_tag,
+		poll_tag_<ChildrenPollPolicy> children_poll_tag,
+		delay_tag_<DelayPolicy> delay_tag,
+		std::size_t topology_version,
+		const worker::parameters &parameters,
+		node &worker_node,
+		node *self_node_ptr,
+		std::vector<node *> child_node_ptrs
+	) const
+	{
+		node * const * const children_begin = child_node_ptrs.data();
+		node * const * const children_end   = children_begin + child_node_ptrs.size();
+		node * const *       child_it       = nullptr;	// nullptr: round not started
+		
+		worker_counters_ counters{parameters.statistics};
+		std::size_t wait_rounds = 0, executed = 0;
+		bool skipped = false;	// Some scheduled context is skipped in the round (it isn't idle, but executes nothing)
+		while (this->worker_continue_(worker_node, topology_version)) {
+			try {
+				while (this->worker_continue_(worker_node, topology_version)) {
+					if (child_it == nullptr) {
+						if (wait_rounds >= parameters.delay_rounds) {
+							wait_rounds = 0;
+							counters.add_delay(worker_node);
+							async_core::worker_delay_(delay_tag, parameters);
+						}
+						
+						executed = 0;
+						skipped = false;
+						child_it = children_begin;
+						executed += async_core::worker_poll_context_(self_poll_tag, self_node_ptr, skipped);
+					}
+					
+					while (child_it != children_end)
+						executed += async_core::worker_poll_context_(children_poll_tag, *child_it++, skipped);
+					
+					counters.add_round(worker_node, executed);
+					if (executed == 0 && !skipped)
+						++wait_rounds;
+					child_it = nullptr;
+				}
+			} catch (const std::exception &e) {
+				this->worker_handle_exception_(e);
 			}
-			
-			std::size_t executed = 0;
-			if (self_poll_method != nullptr)
-				executed += this->worker_poll_context_(*self_context_ptr, self_poll_method);
-			if (children_poll_method != nullptr)
-				executed += this->worker_poll_contexts_(child_context_ptrs, children_poll_method);
-			
-			if (executed == 0)
-				++wait_rounds;
 		}
+		counters.publish(worker_node);
 	}
 	
 	
 	inline
-	std::size_t
-	worker_poll_contexts_(
-		std::vector<boost::asio::io_context *> &child_context_ptrs,
-		poll_method_type poll_method
-	) const
+	bool
+	worker_stopping_() const noexcept
 	{
-		std::size_t executed = 0;
-		for (const auto child_context_ptr: child_context_ptrs)
-			executed += this->worker_poll_context_(*child_context_ptr, poll_method);
-		return executed;
+		// Relaxed: stop() also stops all io_contexts, so blocked workers will return and see the new state.
+		return this->state_.load(std::memory_order_relaxed) == state::stopping;
+	}
+	
+	
+	inline
+	bool
+	worker_topology_actual_(
+		const node &worker_node,
+		std::size_t topology_version
+	) const noexcept
+	{
+		// Relaxed: workers, which may block, are woken up by topology_changed_().
+		return worker_node.topology_version_.load(std::memory_order_relaxed) == topology_version;
+	}
+	
+	
+	inline
+	bool
+	worker_continue_(
+		const node &worker_node,
+		std::size_t topology_version
+	) const noexcept
+	{
+		return !this->worker_stopping_() && this->worker_topology_actual_(worker_node, topology_version);
+	}
+	
+	
+	// Set by wake up task in thread of the worker, which it is posted for (see worker_run_single_()).
+	static inline
+	bool &
+	worker_woken_up_() noexcept
+	{
+		static thread_local bool woken_up = false;
+		return woken_up;
+	}
+	
+	
+	// Requires topology lock. Wakes up the worker of worker_node, which runs context_node in worker_run_single_().
+	// Wake up task is passed between threads running the context, until the worker itself executes it (or leaves
+	// the context).
+	void
+	worker_post_wakeup_(
+		node &worker_node,
+		node &context_node,
+		std::thread::id thread_id
+	)
+	{
+		boost::asio::post(
+			context_node.io_context_,
+			[this, worker_node_ptr = &worker_node, context_node_ptr = &context_node, thread_id]
+			{
+				if (std::this_thread::get_id() == thread_id) {
+					async_core::worker_woken_up_() = true;
+					return;
+				}
+				
+				std::lock_guard<std::mutex> topology_lock{this->topology_mutex_};
+				const auto &single_runs = worker_node_ptr->single_runs_;
+				if (
+					std::find(single_runs.begin(), single_runs.end(), std::make_pair(thread_id, context_node_ptr))
+					!= single_runs.end()
+				)
+					this->worker_post_wakeup_(*worker_node_ptr, *context_node_ptr, thread_id);
+			}
+		);
 	}
 	
 	
 	inline
+	void
+	worker_handle_exception_(
+		const std::exception &e
+	) const
+	{
+		if (this->exception_handler_)
+			this->exception_handler_(e);
+	}
+	
+	
+	static inline
 	std::size_t
 	worker_poll_context_(
-		boost::asio::io_context &context,
-		poll_method_type poll_method
-	) const
+		poll_tag_<worker::poll::disabled>,
+		node * /* node_ptr */,
+		bool & /* skipped */
+	) noexcept
 	{
-		try {
-			return (context.*poll_method)();
-		} catch (const std::exception &e) {
-			if (this->exception_handler_)
-				this->exception_handler_(e);
+		return 0;
+	}
+	
+	
+	template<worker::poll PollPolicy>
+	static inline
+	std::size_t
+	worker_poll_context_(
+		poll_tag_<PollPolicy> poll_tag,
+		node *node_ptr,
+		bool &skipped
+	)
+	{
+		if (node_ptr->scheduled_)	// Never blocks: run_one() is replaced with poll_one()
+			return async_core::worker_poll_scheduled_context_(
+				poll_tag_<(PollPolicy == worker::poll::run_one)? worker::poll::poll_one: PollPolicy>{},
+				*node_ptr,
+				skipped
+			);
+		return async_core::worker_poll_io_context_(poll_tag, node_ptr->io_context_);
+	}
+	
+	
+	// Deficit Round-Robin and rate limits (see context::parameters). Returns number of executed handlers, sets
+	// skipped, if the context is skipped because of deficit.
+	template<worker::poll PollPolicy>
+	static
+	std::size_t
+	worker_poll_scheduled_context_(
+		poll_tag_<PollPolicy> poll_tag,
+		node &n,
+		bool &skipped
+	)
+	{
+		const std::chrono::nanoseconds::rep quantum = n.context_parameters_.quantum.count();
+		
+		std::chrono::nanoseconds::rep deficit = n.deficit_.load(std::memory_order_relaxed);
+		if (quantum > 0 && deficit <= 0) {	// Skip the context, give it next quantum, when its round ends
+			std::size_t skips = n.skips_.fetch_add(1, std::memory_order_relaxed) + 1;
+			if (
+				skips >= n.pollers_.load(std::memory_order_relaxed)
+				&& n.skips_.compare_exchange_strong(skips, 0, std::memory_order_relaxed)
+			)
+				n.deficit_.fetch_add(quantum, std::memory_order_relaxed);
+			skipped = true;	// Not an idle round (the context has been executing tasks), but nothing is executed
 			return 0;
 		}
+		
+		auto start = std::chrono::steady_clock::now();
+		if (!async_core::worker_rate_allowed_(n, start))
+			return 0;	// Idle round: the context is throttled
+		
+		std::size_t executed = 0, poll_executed;
+		do {
+			try {
+				poll_executed = async_core::worker_poll_io_context_(poll_tag, n.io_context_);
+			} catch (...) {
+				async_core::worker_account_(n, quantum, start, 1);
+				throw;
+			}
+			executed += poll_executed;
+			deficit = async_core::worker_account_(n, quantum, start, poll_executed);
+		} while (quantum > 0 && poll_executed > 0 && deficit > 0 && async_core::worker_rate_allowed_(n, start));
+		
+		return executed;
+	}
+	
+	
+	// Accounts time since start and resets start. Returns context's deficit.
+	static inline
+	std::chrono::nanoseconds::rep
+	worker_account_(
+		node &n,
+		std::chrono::nanoseconds::rep quantum,
+		std::chrono::steady_clock::time_point &start,
+		std::size_t executed
+	) noexcept
+	{
+		const auto now = std::chrono::steady_clock::now();
+		const std::chrono::nanoseconds::rep elapsed =
+			std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count();
+		
+		if (executed == 0) {	// Idle poll is not accounted
+			start = now;
+			return n.deficit_.load(std::memory_order_relaxed);
+		}
+		
+		n.handlers_executed_.fetch_add(executed, std::memory_order_relaxed);
+		n.execution_time_.fetch_add(elapsed, std::memory_order_relaxed);
+		
+		const std::chrono::nanoseconds::rep start_ns =
+			std::chrono::duration_cast<std::chrono::nanoseconds>(start.time_since_epoch()).count();
+		if (n.handlers_interval_ > 0)
+			async_core::worker_rate_advance_(
+				n.handlers_tat_,
+				start_ns,
+				n.handlers_interval_ * static_cast<std::chrono::nanoseconds::rep>(executed)
+			);
+		if (n.cpu_factor_ > 0)
+			async_core::worker_rate_advance_(
+				n.cpu_tat_,
+				start_ns,
+				static_cast<std::chrono::nanoseconds::rep>(elapsed * n.cpu_factor_)
+			);
+		start = now;
+		
+		if (quantum > 0)
+			return n.deficit_.fetch_sub(elapsed, std::memory_order_relaxed) - elapsed;
+		return 0;
+	}
+	
+	
+	static inline
+	bool
+	worker_rate_allowed_(
+		const node &n,
+		std::chrono::steady_clock::time_point now
+	) noexcept
+	{
+		const std::chrono::nanoseconds::rep now_ns =
+			std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+		return
+			(n.handlers_interval_ == 0
+			 || n.handlers_tat_.load(std::memory_order_relaxed) - n.handlers_tolerance_ <= now_ns)
+			&& (n.cpu_factor_ == 0 || n.cpu_tat_.load(std::memory_order_relaxed) - n.cpu_tolerance_ <= now_ns);
+	}
+	
+	
+	// Theoretical arrival time can't be behind the time, when execution started: unused rate is not saved
+	// (except tolerance).
+	static inline
+	void
+	worker_rate_advance_(
+		std::atomic<std::chrono::nanoseconds::rep> &tat,
+		std::chrono::nanoseconds::rep start_ns,
+		std::chrono::nanoseconds::rep increment
+	) noexcept
+	{
+		std::chrono::nanoseconds::rep expected = tat.load(std::memory_order_relaxed);
+		while (
+			!tat.compare_exchange_weak(expected, std::max(expected, start_ns) + increment, std::memory_order_relaxed)
+		)
+			;
+	}
+	
+	
+	static inline
+	std::size_t
+	worker_poll_io_context_(
+		poll_tag_<worker::poll::poll_one>,
+		boost::asio::io_context &context
+	)
+	{
+		return context.poll_one();
+	}
+	
+	
+	static inline
+	std::size_t
+	worker_poll_io_context_(
+		poll_tag_<worker::poll::poll_all>,
+		boost::asio::io_context &context
+	)
+	{
+		return context.poll();
+	}
+	
+	
+	static inline
+	std::size_t
+	worker_poll_io_context_(
+		poll_tag_<worker::poll::run_one>,
+		boost::asio::io_context &context
+	)
+	{
+		return context.run_one();
 	}
 	
 	
@@ -1077,22 +2399,56 @@ private:
 	{
 		switch (parameters.delay_policy) {
 			case worker::delay::no_delay:
-				break;
+				return async_core::worker_delay_(delay_tag_<worker::delay::no_delay>{}, parameters);
 			case worker::delay::yield:
-				std::this_thread::yield();
-				break;
+				return async_core::worker_delay_(delay_tag_<worker::delay::yield>{}, parameters);
 			case worker::delay::sleep:
-				std::this_thread::sleep_for(parameters.delay_value);
-				break;
+				return async_core::worker_delay_(delay_tag_<worker::delay::sleep>{}, parameters);
 		}
 	}
 	
 	
+	static inline
+	void
+	worker_delay_(
+		delay_tag_<worker::delay::no_delay>,
+		const worker::parameters & /* parameters */
+	) noexcept
+	{}
+	
+	
+	static inline
+	void
+	worker_delay_(
+		delay_tag_<worker::delay::yield>,
+		const worker::parameters & /* parameters */
+	) noexcept
+	{
+		std::this_thread::yield();
+	}
+	
+	
+	static inline
+	void
+	worker_delay_(
+		delay_tag_<worker::delay::sleep>,
+		const worker::parameters &parameters
+	)
+	{
+		std::this_thread::sleep_for(parameters.delay_value);
+	}
+	
+	
 	
 	std::atomic<state> state_{state::idle};
 	std::mutex stop_mutex_, join_mutex_;
+	
+	// Topology: contexts, their children and workers lists
+	std::mutex topology_mutex_;
+	std::condition_variable topology_condition_;	// Workers without contexts to run wait here
+	
 	node_array nodes_;
-	const std::size_t nodes_count_ = 0;
+	const boost::optional<int> single_worker_concurrency_hint_;
 	exception_handler_type exception_handler_;
 	std::atomic<bool> joined_{false};
 };	// class async_core
@@ -0,0 +1,788 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 08:21
+
+
+// Deterministic discrete-event simulator of async_core. Executes context_tree with its workers and
+// worker::parameters in virtual time: workers poll contexts the same way as async_core's workers do (self context
+// and enabled descendants, poll/delay policies, worker of single context blocks in run_one()), but handlers are
+// virtual tasks with costs from given distributions. Simulation with the same seed gives the same results, and
+// minutes of virtual time take seconds, so poll/delay policies and tree layouts can be compared before deployment.
+//
+// Usage:
+// dkuk::async_core::context_tree t;
+// const auto root = t.add_context(0, 4);
+// const auto io   = t.add_context(root, 1);
+//
+// dkuk::async_core_simulator s{t};
+// s.add_workload(io, 10000, dkuk::async_core_simulator::handler_cost::exponential(std::chrono::microseconds{50}));
+// s.schedule(std::chrono::seconds{1}, [&s, root] { s.post(root, std::chrono::milliseconds{100}); });
+// s.run_for(std::chrono::seconds{10});
+//
+// dkuk::async_core_simulator::context_statistics cs = s.get_context_statistics(io);	// Executed tasks, latency
+// dkuk::async_core_simulator::worker_statistics  ws = s.get_worker_statistics(root, 0);	// Rounds, CPU time
+//
+// Cost model (see parameters):
+// - each poll of io_context (poll_one(), poll() or run_one() call) costs poll_cost of worker's CPU time;
+// - delays: yield costs yield_cost of CPU time, sleep takes delay_value without CPU;
+// - worker blocked in run_one() doesn't use CPU and wakes up wakeup_latency after the task is posted;
+// - each worker has its own CPU core, tasks of one context may be executed by several workers concurrently.
+//
+// Latency of task: time from post to start of its execution. Task is counted as executed, when it is completed.
+//
+// NOTE: Context scheduling (context::parameters: quantum, rate limits, bounded queues) and topology changes
+//       are not simulated.
+// NOTE: Random distributions of the standard library are implementation-defined, so results are reproducible
+//       with the same standard library only.
+//
+// Thread-safety:
+// - async_core_simulator:
+//     + distinct objects: safe;
+//     + shared object: unsafe.
+
+
+#ifndef DKUK_ASYNC_CORE_SIMULATOR_HPP
+#define DKUK_ASYNC_CORE_SIMULATOR_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <dkuk/async_core.hpp>
+
+
+namespace dkuk {
+
+
+class async_core_simulator
+{
+public:
+	using context_id_type = async_core::context_id_type;
+	using worker_id_type  = async_core::worker_id_type;
+	using duration        = std::chrono::nanoseconds;
+	
+	
+	
+	// Distribution of handler execution time.
+	class handler_cost
+	{
+	public:
+		static inline
+		handler_cost
+		constant(
+			duration value
+		)
+		{
+			return handler_cost{kind::constant, value, value};
+		}
+		
+		
+		static inline
+		handler_cost
+		uniform(
+			duration min,
+			duration max
+		)
+		{
+			if (min > max)
+				throw std::invalid_argument{"Incorrect handler cost range"};
+			return handler_cost{kind::uniform, min, max};
+		}
+		
+		
+		static inline
+		handler_cost
+		exponential(
+			duration mean
+		)
+		{
+			if (mean <= duration::zero())
+				throw std::invalid_argument{"Mean handler cost should be positive"};
+			return handler_cost{kind::exponential, mean, mean};
+		}
+		
+		
+		template<class RandomEngine>
+		duration
+		operator()(
+			RandomEngine &engine
+		) const
+		{
+			switch (this->kind_) {
+				case kind::constant:
+					return this->a_;
+				case kind::uniform:
+					return duration{
+						std::uniform_int_distribution<duration::rep>{this->a_.count(), this->b_.count()}(engine)
+					};
+				case kind::exponential:
+					return duration{
+						static_cast<duration::rep>(
+							std::exponential_distribution<double>{1.0 / this->a_.count()}(engine)
+						)
+					};
+			}
+			return this->a_;
+		}
+	private:
+		enum class kind
+		{
+			constant,
+			uniform,
+			exponential
+		};	// enum class kind
+		
+		
+		
+		inline
+		handler_cost(
+			kind k,
+			duration a,
+			duration b
+		) noexcept:
+			kind_{k},
+			a_{a},
+			b_{b}
+		{}
+		
+		
+		
+		kind kind_;
+		duration a_, b_;
+	};	// class handler_cost
+	
+	
+	
+	struct parameters
+	{
+		duration      poll_cost      = std::chrono::nanoseconds{100};	// Should be positive
+		duration      yield_cost     = std::chrono::microseconds{1};
+		duration      wakeup_latency = std::chrono::microseconds{10};
+		std::uint64_t seed           = 1;
+	};	// struct parameters
+	
+	
+	
+	struct context_statistics
+	{
+		std::size_t tasks_posted   = 0;
+		std::size_t tasks_executed = 0;
+		std::size_t tasks_queued   = 0;	// Not started yet
+		duration    mean_latency   = duration::zero();
+		duration    p99_latency    = duration::zero();
+		duration    max_latency    = duration::zero();
+	};	// struct context_statistics
+	
+	
+	
+	// Same counters as async_core::worker::statistics and worker's time (in sum equal to the simulated time, but
+	// handler in progress is accounted at its start).
+	struct worker_statistics
+	{
+		std::size_t rounds            = 0;
+		std::size_t idle_rounds       = 0;
+		std::size_t delays            = 0;
+		std::size_t handlers_executed = 0;
+		
+		duration    busy_time         = duration::zero();	// Executing handlers
+		duration    overhead_time     = duration::zero();	// Polls and yields: CPU time without handlers
+		duration    delay_time        = duration::zero();	// Sleeping
+		duration    blocked_time      = duration::zero();	// Blocked in run_one()
+		duration    idle_time         = duration::zero();	// Nothing to run
+	};	// struct worker_statistics
+	
+	
+	
+	explicit
+	async_core_simulator(
+		const async_core::context_tree &t
+	):
+		async_core_simulator{t, parameters{}}
+	{}
+	
+	
+	async_core_simulator(
+		const async_core::context_tree &t,
+		const parameters &p
+	):
+		parameters_(p),
+		engine_{p.seed},
+		contexts_(t.get_contexts_count())
+	{
+		if (this->parameters_.poll_cost <= duration::zero())
+			throw std::invalid_argument{"Poll cost should be positive"};
+		
+		for (context_id_type id = 0; id < this->contexts_.size(); ++id) {
+			this->contexts_[id].enabled = t.is_enabled(id);
+			if (id != 0)
+				this->contexts_[t.get_parent_id(id)].children_ids.push_back(id);
+		}
+		
+		for (context_id_type id = 0; id < this->contexts_.size(); ++id) {	// Plans of workers need all contexts
+			this->contexts_[id].first_worker_index = this->workers_.size();
+			for (const auto &worker_parameters: t.get_worker_parameters(id))
+				this->workers_.push_back(this->make_worker_(id, worker_parameters));
+		}
+		
+		for (std::size_t i = 0; i < this->workers_.size(); ++i)
+			if (this->workers_[i].mode != worker_mode::idle)
+				this->schedule_worker_(i, this->now_);
+	}
+	
+	
+	async_core_simulator(
+		const async_core_simulator &other
+	) = delete;
+	
+	
+	async_core_simulator &
+	operator=(
+		const async_core_simulator &other
+	) = delete;
+	
+	
+	// Virtual time since simulation start.
+	inline
+	duration
+	now() const noexcept
+	{
+		return this->now_;
+	}
+	
+	
+	inline
+	void
+	post(
+		context_id_type context_id,
+		duration cost
+	)
+	{
+		context &c = this->contexts_.at(context_id);
+		c.tasks.push_back(task{this->now_, cost});
+		++c.tasks_posted;
+		
+		if (!c.blocked_worker_indexes.empty()) {	// Wake up one worker blocked in run_one()
+			const std::size_t worker_index = c.blocked_worker_indexes.front();
+			c.blocked_worker_indexes.pop_front();
+			
+			worker &w = this->workers_[worker_index];
+			w.blocked = false;
+			w.statistics.blocked_time += this->now_ - w.blocked_since + this->parameters_.wakeup_latency;
+			this->schedule_worker_(worker_index, this->now_ + this->parameters_.wakeup_latency);
+		}
+	}
+	
+	
+	inline
+	void
+	post(
+		context_id_type context_id,
+		const handler_cost &cost
+	)
+	{
+		this->post(context_id, cost(this->engine_));
+	}
+	
+	
+	// Calls f (which may post tasks and schedule calls) after delay of virtual time.
+	inline
+	void
+	schedule(
+		duration delay,
+		std::function<void ()> f
+	)
+	{
+		const std::uint64_t number = this->events_count_++;
+		this->callbacks_.emplace(number, std::move(f));
+		this->callback_events_.push(event{this->now_ + delay, number, no_worker_});
+	}
+	
+	
+	// Poisson flow of tasks: tasks_per_second on average.
+	void
+	add_workload(
+		context_id_type context_id,
+		double tasks_per_second,
+		handler_cost cost
+	)
+	{
+		if (tasks_per_second <= 0)
+			throw std::invalid_argument{"Tasks rate should be positive"};
+		this->contexts_.at(context_id);	// Check id
+		
+		auto next = std::make_shared<std::function<void ()>>();
+		*next =
+			[this, context_id, tasks_per_second, cost, next_weak = std::weak_ptr<std::function<void ()>>{next}]
+			{
+				this->post(context_id, cost);
+				this->schedule(this->next_arrival_delay_(tasks_per_second), *next_weak.lock());
+			};
+		this->workloads_.push_back(next);
+		this->schedule(this->next_arrival_delay_(tasks_per_second), *next);
+	}
+	
+	
+	// Simulates the next duration of virtual time.
+	void
+	run_for(
+		duration d
+	)
+	{
+		this->end_ = this->now_ + d;
+		while (true) {
+			const bool has_worker_event = !this->worker_events_.empty(),
+				has_callback_event = !this->callback_events_.empty();
+			if (
+				has_callback_event
+				&& (!has_worker_event || this->worker_events_.top() > this->callback_events_.top())
+			) {
+				const event e = this->callback_events_.top();
+				if (e.time > this->end_)
+					break;
+				this->callback_events_.pop();
+				this->now_ = e.time;
+				
+				const auto it = this->callbacks_.find(e.number);
+				const std::function<void ()> f = std::move(it->second);
+				this->callbacks_.erase(it);
+				f();
+			} else if (has_worker_event) {
+				const event e = this->worker_events_.top();
+				if (e.time > this->end_)
+					break;
+				this->worker_events_.pop();
+				this->now_ = e.time;
+				this->step_worker_(e.worker_index);
+			} else {
+				break;
+			}
+		}
+		this->now_ = this->end_;
+	}
+	
+	
+	context_statistics
+	get_context_statistics(
+		context_id_type context_id
+	) const
+	{
+		const context &c = this->contexts_.at(context_id);
+		
+		context_statistics res;
+		res.tasks_posted   = c.tasks_posted;
+		res.tasks_executed = c.tasks_executed;
+		res.tasks_queued   = c.tasks.size();
+		if (!c.latencies.empty()) {
+			std::vector<duration::rep> latencies = c.latencies;
+			duration::rep sum = 0;
+			for (const auto latency: latencies)
+				sum += latency;
+			res.mean_latency = duration{sum / static_cast<duration::rep>(latencies.size())};
+			
+			const auto p99 = latencies.begin() + static_cast<std::ptrdiff_t>(latencies.size() * 99 / 100);
+			std::nth_element(latencies.begin(), p99, latencies.end());
+			res.p99_latency = duration{*p99};
+			res.max_latency = duration{*std::max_element(latencies.begin(), latencies.end())};
+		}
+		return res;
+	}
+	
+	
+	inline
+	worker_statistics
+	get_worker_statistics(
+		context_id_type context_id,
+		worker_id_type worker_id
+	) const
+	{
+		const context &c = this->contexts_.at(context_id);
+		if (worker_id >= this->workers_.size() - c.first_worker_index
+			|| this->workers_[c.first_worker_index + worker_id].context_id != context_id)
+			throw std::out_of_range{"Incorrect worker id"};
+		
+		const worker &w = this->workers_[c.first_worker_index + worker_id];
+		worker_statistics res = w.statistics;
+		if (w.mode == worker_mode::idle)
+			res.idle_time = this->now_;
+		else if (w.blocked)
+			res.blocked_time += this->now_ - w.blocked_since;
+		else if (w.executing && w.executing_until > this->now_)	// Only elapsed part of the task in progress
+			res.busy_time -= std::min(w.executing_until - this->now_, w.executing_cost);
+		return res;
+	}
+private:
+	struct task
+	{
+		duration posted;
+		duration cost;
+	};	// struct task
+	
+	
+	
+	struct context
+	{
+		std::vector<context_id_type> children_ids;
+		bool enabled = true;
+		std::size_t first_worker_index = 0;
+		
+		std::deque<task> tasks;
+		std::deque<std::size_t> blocked_worker_indexes;	// Workers blocked in run_one()
+		
+		std::size_t tasks_posted = 0, tasks_executed = 0;
+		std::vector<duration::rep> latencies;
+	};	// struct context
+	
+	
+	
+	enum class worker_mode
+	{
+		idle,		// Nothing to run
+		single,		// One context, run_one() in loop (see async_core::worker_run_single_())
+		multiple	// Rounds over contexts (see async_core::worker_run_multiple_())
+	};	// enum class worker_mode
+	
+	
+	
+	struct worker
+	{
+		context_id_type context_id;
+		async_core::worker::parameters parameters;
+		worker_mode mode = worker_mode::idle;
+		std::vector<context_id_type> plan;	// Contexts to run: self (if polled) and enabled descendants
+		std::size_t self_count = 0;			// 1, if plan starts with self context
+		
+		// Loop state
+		std::size_t position = 0;			// In plan
+		bool round_started = false, draining = false;	// Draining: poll() of plan[position] is in progress
+		std::size_t executed = 0, wait_rounds = 0;
+		
+		// Task in progress: counted, when the worker continues
+		bool executing = false;
+		context_id_type executing_context_id = 0;
+		duration executing_until = duration::zero(), executing_cost = duration::zero();
+		
+		bool blocked = false;
+		duration blocked_since = duration::zero();
+		worker_statistics statistics;
+	};	// struct worker
+	
+	
+	
+	// Worker's step or scheduled call (see callbacks_).
+	struct event
+	{
+		duration time;
+		std::uint64_t number;	// Events of the same time are ordered by scheduling
+		std::size_t worker_index;
+		
+		
+		inline
+		bool
+		operator>(
+			const event &other
+		) const noexcept
+		{
+			return this->time > other.time || (this->time == other.time && this->number > other.number);
+		}
+	};	// struct event
+	
+	
+	
+	static constexpr std::size_t no_worker_ = std::numeric_limits<std::size_t>::max();
+	
+	
+	
+	// Same plan as async_core::worker_run_() builds.
+	worker
+	make_worker_(
+		context_id_type context_id,
+		const async_core::worker::parameters &parameters
+	) const
+	{
+		worker w;
+		w.context_id = context_id;
+		w.parameters = parameters;
+		
+		if (parameters.self_poll_policy != async_core::worker::poll::disabled && this->contexts_[context_id].enabled) {
+			w.plan.push_back(context_id);
+			w.self_count = 1;
+		}
+		
+		if (parameters.children_poll_policy != async_core::worker::poll::disabled) {
+			std::queue<context_id_type> ids_queue;
+			for (const auto child_id: this->contexts_[context_id].children_ids)
+				ids_queue.push(child_id);
+			
+			while (!ids_queue.empty()) {
+				const context_id_type id = ids_queue.front();
+				ids_queue.pop();
+				
+				if (this->contexts_[id].enabled)
+					w.plan.push_back(id);
+				for (const auto child_id: this->contexts_[id].children_ids)
+					ids_queue.push(child_id);
+			}
+		}
+		
+		if (w.plan.empty())
+			w.mode = worker_mode::idle;
+		else if (w.plan.size() == 1)
+			w.mode = worker_mode::single;
+		else
+			w.mode = worker_mode::multiple;
+		return w;
+	}
+	
+	
+	inline
+	duration
+	next_arrival_delay_(
+		double tasks_per_second
+	)
+	{
+		const double seconds = std::exponential_distribution<double>{tasks_per_second}(this->engine_);
+		return std::chrono::duration_cast<duration>(std::chrono::duration<double>{seconds});
+	}
+	
+	
+	inline
+	void
+	schedule_worker_(
+		std::size_t worker_index,
+		duration time
+	)
+	{
+		this->worker_events_.push(event{time, this->events_count_++, worker_index});
+	}
+	
+	
+	// Takes the oldest task of the context and executes it since start: returns time of its completion.
+	duration
+	execute_(
+		worker &w,
+		context_id_type context_id,
+		duration start
+	)
+	{
+		context &c = this->contexts_[context_id];
+		const task t = c.tasks.front();
+		c.tasks.pop_front();
+		c.latencies.push_back((start - t.posted).count());
+		
+		++w.statistics.handlers_executed;
+		w.statistics.busy_time += t.cost;
+		w.executing = true;
+		w.executing_context_id = context_id;
+		w.executing_until = start + t.cost;
+		w.executing_cost = t.cost;
+		return start + t.cost;
+	}
+	
+	
+	inline
+	void
+	block_(
+		std::size_t worker_index,
+		context_id_type context_id
+	)
+	{
+		worker &w = this->workers_[worker_index];
+		w.blocked = true;
+		w.blocked_since = this->now_;
+		this->contexts_[context_id].blocked_worker_indexes.push_back(worker_index);
+	}
+	
+	
+	// Accounts idle rounds of the worker, which is just after the delay (or at its first round), until the next
+	// callback: its contexts stay empty till then, so each cycle of delay_rounds idle rounds and the delay is the same.
+	// Returns true, if some rounds are skipped (the worker is scheduled after them).
+	bool
+	skip_idle_rounds_(
+		std::size_t worker_index
+	)
+	{
+		worker &w = this->workers_[worker_index];
+		const auto &parameters = w.parameters;
+		for (std::size_t i = 0; i < w.plan.size(); ++i) {
+			const async_core::worker::poll policy =
+				(i < w.self_count)? parameters.self_poll_policy: parameters.children_poll_policy;
+			if (policy == async_core::worker::poll::run_one || !this->contexts_[w.plan[i]].tasks.empty())
+				return false;
+		}
+		
+		const std::size_t cycle_rounds = std::max<std::size_t>(parameters.delay_rounds, 1);
+		duration
+			cycle_overhead = this->parameters_.poll_cost * static_cast<duration::rep>(cycle_rounds * w.plan.size()),
+			cycle_delay    = duration::zero();
+		if (parameters.delay_policy == async_core::worker::delay::yield)
+			cycle_overhead += this->parameters_.yield_cost;
+		else if (parameters.delay_policy == async_core::worker::delay::sleep)
+			cycle_delay = parameters.delay_value;
+		
+		duration horizon = this->end_;
+		if (!this->callback_events_.empty())
+			horizon = std::min(horizon, this->callback_events_.top().time);
+		if (horizon <= this->now_)
+			return false;
+		const duration::rep cycles = (horizon - this->now_) / (cycle_overhead + cycle_delay);
+		if (cycles == 0)
+			return false;
+		
+		w.statistics.rounds        += cycles * cycle_rounds;
+		w.statistics.idle_rounds   += cycles * cycle_rounds;
+		w.statistics.delays        += cycles;
+		w.statistics.overhead_time += cycle_overhead * cycles;
+		w.statistics.delay_time    += cycle_delay * cycles;
+		this->schedule_worker_(worker_index, this->now_ + (cycle_overhead + cycle_delay) * cycles);
+		return true;
+	}
+	
+	
+	// Continues worker's loop from now until it has to wait (executes a task, polls, delays or blocks).
+	void
+	step_worker_(
+		std::size_t worker_index
+	)
+	{
+		worker &w = this->workers_[worker_index];
+		if (w.executing) {
+			w.executing = false;
+			++this->contexts_[w.executing_context_id].tasks_executed;
+		}
+		
+		if (w.mode == worker_mode::single) {
+			context &c = this->contexts_[w.plan.front()];
+			if (c.tasks.empty()) {
+				this->block_(worker_index, w.plan.front());
+				return;
+			}
+			++w.statistics.rounds;
+			this->schedule_worker_(worker_index, this->execute_(w, w.plan.front(), this->now_));
+			return;
+		}
+		
+		const auto &parameters = w.parameters;
+		while (true) {
+			// Round start: delay after idle rounds
+			if (!w.round_started) {
+				w.round_started = true;
+				w.executed = 0;
+				if (w.wait_rounds >= parameters.delay_rounds) {
+					w.wait_rounds = 0;
+					++w.statistics.delays;
+					duration delay = duration::zero();
+					switch (parameters.delay_policy) {
+						case async_core::worker::delay::no_delay:
+							break;
+						case async_core::worker::delay::yield:
+							delay = this->parameters_.yield_cost;
+							w.statistics.overhead_time += delay;
+							break;
+						case async_core::worker::delay::sleep:
+							delay = parameters.delay_value;
+							w.statistics.delay_time += delay;
+							break;
+					}
+					if (delay > duration::zero()) {
+						this->schedule_worker_(worker_index, this->now_ + delay);
+						return;
+					}
+				}
+			}
+			
+			if (w.position == 0 && w.wait_rounds == 0 && this->skip_idle_rounds_(worker_index))
+				return;
+			
+			// Round end
+			if (w.position == w.plan.size()) {
+				++w.statistics.rounds;
+				if (w.executed == 0) {
+					++w.statistics.idle_rounds;
+					++w.wait_rounds;
+				}
+				w.position = 0;
+				w.round_started = false;
+				continue;
+			}
+			
+			const context_id_type context_id = w.plan[w.position];
+			const async_core::worker::poll policy =
+				(w.position < w.self_count)? parameters.self_poll_policy: parameters.children_poll_policy;
+			const bool has_task = !this->contexts_[context_id].tasks.empty();
+			
+			if (policy == async_core::worker::poll::poll_all && w.draining) {	// poll() continues
+				if (!has_task) {
+					w.draining = false;
+					++w.position;
+					continue;
+				}
+				++w.executed;
+				this->schedule_worker_(worker_index, this->execute_(w, context_id, this->now_));
+				return;
+			}
+			
+			// New call of poll_one(), poll() or run_one()
+			const duration poll_cost = this->parameters_.poll_cost;
+			w.statistics.overhead_time += poll_cost;
+			switch (policy) {
+				case async_core::worker::poll::disabled:
+					++w.position;
+					w.statistics.overhead_time -= poll_cost;
+					continue;
+				case async_core::worker::poll::poll_one:
+					++w.position;
+					if (has_task) {
+						++w.executed;
+						this->schedule_worker_(worker_index, this->execute_(w, context_id, this->now_ + poll_cost));
+					} else {
+						this->schedule_worker_(worker_index, this->now_ + poll_cost);
+					}
+					return;
+				case async_core::worker::poll::poll_all:
+					w.draining = true;
+					this->schedule_worker_(worker_index, this->now_ + poll_cost);
+					return;
+				case async_core::worker::poll::run_one:
+					if (has_task) {
+						++w.position;
+						++w.executed;
+						this->schedule_worker_(worker_index, this->execute_(w, context_id, this->now_ + poll_cost));
+					} else {
+						this->block_(worker_index, context_id);	// Retries run_one() after wake up
+					}
+					return;
+			}
+		}
+	}
+	
+	
+	
+	const parameters parameters_;
+	std::mt19937_64 engine_;
+	duration now_ = duration::zero();
+	
+	std::vector<context> contexts_;
+	std::vector<worker> workers_;
+	
+	duration end_ = duration::zero();	// Of current run_for()
+	
+	// Tasks are posted by callbacks only, so workers skip idle rounds until the next callback (see skip_idle_rounds_())
+	std::priority_queue<event, std::vector<event>, std::greater<event>> worker_events_, callback_events_;
+	std::uint64_t events_count_ = 0;
+	std::unordered_map<std::uint64_t, std::function<void ()>> callbacks_;	// By event number
+	std::vector<std::shared_ptr<std::function<void ()>>> workloads_;
+};	// class async_core_simulator
+
+
+};	// namespace dkuk
+
+
+#endif	// DKUK_ASYNC_CORE_SIMULATOR_HPP
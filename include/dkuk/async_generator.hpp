@@ -0,0 +1,215 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 06:57
+
+
+// Generator, which produces values on its own stack (Boost.Context continuation) for a consumer coroutine. Each
+// value is handed over by pointer through a direct context switch: no queues, allocations or copies per element.
+// Producer runs in the consumer's thread (and executor) and may use the consumer's coroutine_context for async
+// operations: the whole chain (consumer + producer) is suspended then.
+//
+// Usage:
+// dkuk::async_generator<record> records{
+//     [&s](dkuk::async_generator<record>::yield_type yield, dkuk::coroutine_context context)
+//     {
+//         while (/* ... */) {
+//             std::size_t bytes_transferred = s.async_receive(/* ... */, context);
+//             record r = parse(/* ... */);
+//             yield(r);    // Consumer gets pointer to r
+//         }
+//     }
+// };
+//
+// void consume(dkuk::coroutine_context context)
+// {
+//     while (record *r = records.next(context))
+//         process(*r);
+// }
+//
+// NOTE: Value is valid until the next call of next() (or generator destruction).
+// NOTE: Exceptions thrown by producer are rethrown from next(), generator is finished then.
+// NOTE: Producer, which is not finished, is unwound on generator destruction.
+// NOTE: Producer gets context of the first consumer and keeps it, so generator can be consumed by one coroutine
+//       only: next() throws std::logic_error for other coroutines.
+//
+// Thread-safety:
+// - async_generator:
+//     + distinct objects: safe;
+//     + shared object: unsafe (should be consumed by one coroutine).
+
+
+#ifndef DKUK_ASYNC_GENERATOR_HPP
+#define DKUK_ASYNC_GENERATOR_HPP
+
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/context/continuation.hpp>
+#include <boost/optional.hpp>
+
+#include <dkuk/coroutine.hpp>
+
+
+namespace dkuk {
+
+
+template<class T>
+class async_generator
+{
+public:
+	class yield_type
+	{
+	public:
+		inline
+		void
+		operator()(
+			T &value
+		) const
+		{
+			this->generator_ptr_->yield_(std::addressof(value));
+		}
+		
+		
+		// Temporary lives until the end of full expression, so consumer gets it before destruction.
+		inline
+		void
+		operator()(
+			T &&value
+		) const
+		{
+			this->generator_ptr_->yield_(std::addressof(value));
+		}
+	private:
+		friend class async_generator;
+		
+		
+		
+		explicit
+		yield_type(
+			async_generator &generator
+		) noexcept:
+			generator_ptr_{&generator}
+		{}
+		
+		
+		
+		async_generator *generator_ptr_;
+	};	// class yield_type
+	
+	
+	
+	// Fn signature: void (yield_type yield, coroutine_context context).
+	template<class Fn>
+	explicit
+	async_generator(
+		Fn &&fn
+	):
+		producer_{boost::context::callcc(this->wrap_fn_(std::forward<Fn>(fn)))}
+	{}
+	
+	
+	template<class StackAlloc, class Fn>
+	async_generator(
+		std::allocator_arg_t,
+		StackAlloc salloc,
+		Fn &&fn
+	):
+		producer_{boost::context::callcc(std::allocator_arg, std::move(salloc), this->wrap_fn_(std::forward<Fn>(fn)))}
+	{}
+	
+	
+	// Not copyable, not movable: producer refers to the generator.
+	async_generator(
+		const async_generator &other
+	) = delete;
+	
+	
+	async_generator &
+	operator=(
+		const async_generator &other
+	) = delete;
+	
+	
+	// Resumes producer until it yields the next value. Returns nullptr, if producer is finished.
+	inline
+	T *
+	next(
+		const coroutine_context &context
+	)
+	{
+		if (!this->producer_)
+			return nullptr;
+		
+		if (!this->consumer_context_)	// Producer is started with it
+			this->consumer_context_ = context;
+		else if (*this->consumer_context_ != context)
+			throw std::logic_error{"Generator is consumed by another coroutine"};
+		
+		this->value_ptr_ = nullptr;
+		this->producer_ = this->producer_.resume();
+		
+		if (this->exception_ptr_ != nullptr) {
+			const std::exception_ptr exception_ptr = std::move(this->exception_ptr_);
+			this->exception_ptr_ = nullptr;
+			std::rethrow_exception(exception_ptr);
+		}
+		return this->value_ptr_;
+	}
+	
+	
+	inline
+	bool
+	finished() const noexcept
+	{
+		return !this->producer_;
+	}
+private:
+	template<class Fn>
+	inline
+	auto
+	wrap_fn_(
+		Fn &&fn
+	)
+	{
+		return
+			[this, fn = std::forward<Fn>(fn)](boost::context::continuation &&consumer) mutable
+			{
+				// False-start: producer is started by the first next()
+				this->consumer_ptr_ = std::addressof(consumer);
+				*this->consumer_ptr_ = this->consumer_ptr_->resume();
+				
+				try {
+					std::move(fn)(yield_type{*this}, *this->consumer_context_);
+				} catch (const std::exception & /* e */) {
+					this->exception_ptr_ = std::current_exception();
+				}
+				
+				return std::move(consumer);
+			};
+	}
+	
+	
+	inline
+	void
+	yield_(
+		T *value_ptr
+	)
+	{
+		this->value_ptr_ = value_ptr;
+		*this->consumer_ptr_ = this->consumer_ptr_->resume();
+	}
+	
+	
+	
+	boost::context::continuation *consumer_ptr_ = nullptr;
+	boost::optional<coroutine_context> consumer_context_;
+	T *value_ptr_ = nullptr;
+	std::exception_ptr exception_ptr_;
+	boost::context::continuation producer_;	// Last: it's started by constructor and unwound first by destructor
+};	// class async_generator
+
+
+};	// namespace dkuk
+
+
+#endif	// DKUK_ASYNC_GENERATOR_HPP
@@ -0,0 +1,502 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 07:18
+
+
+// Pool of I/O buffers: Asio service, so each io_context (i.e. each async_core context) has its own one. Buffers are
+// size-classed (powers of two from min_size to max_size), released buffers are recycled through per-thread cache
+// (no locking at all), then through the pool's shared lists. Bigger buffers are allocated and freed directly.
+//
+// Usage:
+// dkuk::buffer_pool &pool = boost::asio::use_service<dkuk::buffer_pool>(core.get_io_context(context_id));
+// dkuk::pooled_buffer b = pool.acquire(4096);	// Or: context.acquire_buffer(4096) inside coroutine
+//
+// std::size_t bytes_transferred = s.async_read_some(b.buffer(), context);	// No copying: buffer is read in place
+// boost::asio::async_write(s, b.buffer(bytes_transferred), context);
+//
+// NOTE: To change limits, create the service before the first use:
+//       boost::asio::make_service<dkuk::buffer_pool>(io_context, dkuk::buffer_pool::parameters{...}).
+// NOTE: Buffers should be released (destroyed) before the io_context destruction.
+// NOTE: Thread caches are shared by all pools (blocks are plain memory), so per-pool isolation holds for the shared
+//       lists only: block released to one pool may be acquired from another one by the same thread. Thread cache
+//       is limited by max_thread_cached of the pool, which releases the block, and pool's statistics don't count
+//       thread caches.
+//
+// Thread-safety:
+// - buffer_pool:
+//     + distinct objects: safe;
+//     + shared object: safe.
+// - pooled_buffer:
+//     + distinct objects: safe;
+//     + shared object: unsafe.
+
+
+#ifndef DKUK_BUFFER_POOL_HPP
+#define DKUK_BUFFER_POOL_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/execution_context.hpp>
+
+
+namespace dkuk {
+
+
+class buffer_pool;
+
+
+
+// Owner of pooled memory block (move-only). Block is returned to the pool on destruction.
+class pooled_buffer
+{
+public:
+	pooled_buffer() noexcept = default;
+	
+	
+	inline
+	pooled_buffer(
+		pooled_buffer &&other
+	) noexcept:
+		pool_ptr_{other.pool_ptr_},
+		data_{other.data_},
+		size_{other.size_},
+		capacity_{other.capacity_}
+	{
+		other.pool_ptr_ = nullptr;
+		other.data_ = nullptr;
+		other.size_ = 0;
+		other.capacity_ = 0;
+	}
+	
+	
+	inline
+	pooled_buffer &
+	operator=(
+		pooled_buffer &&other
+	) noexcept
+	{
+		if (this != &other) {
+			this->release();
+			std::swap(this->pool_ptr_, other.pool_ptr_);
+			std::swap(this->data_, other.data_);
+			std::swap(this->size_, other.size_);
+			std::swap(this->capacity_, other.capacity_);
+		}
+		return *this;
+	}
+	
+	
+	inline
+	~pooled_buffer();
+	
+	
+	inline
+	void *
+	data() const noexcept
+	{
+		return this->data_;
+	}
+	
+	
+	// Requested size.
+	inline
+	std::size_t
+	size() const noexcept
+	{
+		return this->size_;
+	}
+	
+	
+	// Size of the block: size can be increased up to it without reallocation.
+	inline
+	std::size_t
+	capacity() const noexcept
+	{
+		return this->capacity_;
+	}
+	
+	
+	inline
+	void
+	resize(
+		std::size_t size
+	)
+	{
+		if (size > this->capacity_)
+			throw std::length_error{"Pooled buffer size exceeds capacity"};
+		this->size_ = size;
+	}
+	
+	
+	// Buffer sequence for Asio operations (refers to the block, doesn't copy it).
+	inline
+	boost::asio::mutable_buffer
+	buffer() const noexcept
+	{
+		return boost::asio::mutable_buffer{this->data_, this->size_};
+	}
+	
+	
+	// Same as above, but only first size bytes (e.g. bytes_transferred by the previous read).
+	inline
+	boost::asio::mutable_buffer
+	buffer(
+		std::size_t size
+	) const noexcept
+	{
+		return boost::asio::mutable_buffer{this->data_, std::min(size, this->size_)};
+	}
+	
+	
+	explicit
+	inline
+	operator bool() const noexcept
+	{
+		return this->data_ != nullptr;
+	}
+	
+	
+	// Returns the block to the pool, buffer becomes empty.
+	inline
+	void
+	release() noexcept;
+private:
+	friend class buffer_pool;
+	
+	
+	
+	inline
+	pooled_buffer(
+		buffer_pool *pool_ptr,
+		void *data,
+		std::size_t size,
+		std::size_t capacity
+	) noexcept:
+		pool_ptr_{pool_ptr},
+		data_{data},
+		size_{size},
+		capacity_{capacity}
+	{}
+	
+	
+	
+	buffer_pool *pool_ptr_ = nullptr;
+	void *data_ = nullptr;
+	std::size_t size_ = 0;
+	std::size_t capacity_ = 0;
+};	// class pooled_buffer
+
+
+
+namespace buffer_pool_impl {
+
+
+// Static service id for header-only service.
+template<class Service>
+class service_id
+{
+public:
+	static boost::asio::execution_context::id id;
+};	// class service_id
+
+
+template<class Service>
+boost::asio::execution_context::id service_id<Service>::id;
+
+
+};	// namespace buffer_pool_impl
+
+
+
+class buffer_pool:
+	public boost::asio::execution_context::service,
+	public buffer_pool_impl::service_id<buffer_pool>
+{
+public:
+	using key_type = buffer_pool;
+	
+	
+	static constexpr std::size_t min_size = 512;
+	static constexpr std::size_t max_size = 64 * 1024;
+	static constexpr std::size_t size_classes_count = 8;	// min_size * 2^i
+	
+	
+	
+	struct parameters
+	{
+		std::size_t max_cached        = 256;	// Max free blocks of each size class in the pool
+		std::size_t max_thread_cached = 32;	// Max free blocks of each size class in the cache of each thread
+	};	// struct parameters
+	
+	
+	
+	struct statistics
+	{
+		std::size_t acquired_count  = 0;	// Buffers taken from the pool's lists (not from thread caches)
+		std::size_t allocated_count = 0;	// Blocks allocated, because caches and lists were empty
+	};	// struct statistics
+	
+	
+	
+	explicit
+	buffer_pool(
+		boost::asio::execution_context &context
+	):
+		buffer_pool{context, buffer_pool::parameters{}}
+	{}
+	
+	
+	buffer_pool(
+		boost::asio::execution_context &context,
+		const parameters &parameters
+	):
+		boost::asio::execution_context::service{context},
+		parameters_{parameters}
+	{}
+	
+	
+	inline
+	~buffer_pool()
+	{
+		for (auto &list: this->lists_)
+			buffer_pool::free_blocks_(list.head_);
+	}
+	
+	
+	pooled_buffer
+	acquire(
+		std::size_t size
+	)
+	{
+		if (size > max_size)
+			return pooled_buffer{this, ::operator new(size), size, size};
+		
+		const std::size_t size_class = buffer_pool::size_class_(size);
+		const std::size_t capacity = min_size << size_class;
+		
+		// Thread cache: no locking
+		thread_cache &c = buffer_pool::thread_cache_();
+		block *block_ptr = c.heads_[size_class];
+		if (block_ptr != nullptr) {
+			c.heads_[size_class] = block_ptr->next_;
+			--c.sizes_[size_class];
+			return pooled_buffer{this, block_ptr, size, capacity};
+		}
+		
+		// Shared list
+		shared_list &list = this->lists_[size_class];
+		{
+			std::lock_guard<std::mutex> lock{list.mutex_};
+			block_ptr = list.head_;
+			if (block_ptr != nullptr) {
+				list.head_ = block_ptr->next_;
+				--list.size_;
+			}
+		}
+		
+		if (block_ptr != nullptr) {
+			this->acquired_count_.fetch_add(1, std::memory_order_relaxed);
+			return pooled_buffer{this, block_ptr, size, capacity};
+		}
+		
+		this->allocated_count_.fetch_add(1, std::memory_order_relaxed);
+		return pooled_buffer{this, ::operator new(capacity), size, capacity};
+	}
+	
+	
+	inline
+	const parameters &
+	get_parameters() const noexcept
+	{
+		return this->parameters_;
+	}
+	
+	
+	inline
+	statistics
+	get_statistics() const noexcept
+	{
+		statistics res;
+		res.acquired_count  = this->acquired_count_.load(std::memory_order_relaxed);
+		res.allocated_count = this->allocated_count_.load(std::memory_order_relaxed);
+		return res;
+	}
+private:
+	friend class pooled_buffer;
+	
+	
+	
+	struct block
+	{
+		block *next_;
+	};	// struct block
+	
+	
+	
+	struct shared_list
+	{
+		std::mutex mutex_;
+		block *head_ = nullptr;
+		std::size_t size_ = 0;
+	};	// struct shared_list
+	
+	
+	
+	// Blocks don't belong to any pool while they are in thread cache, so one cache serves all pools. Cache is
+	// trivially destructible, so it stays valid during the whole thread exit (buffers may be released by other
+	// thread_local objects after the cleaner).
+	struct thread_cache
+	{
+		std::array<block *, size_classes_count> heads_{};
+		std::array<std::size_t, size_classes_count> sizes_{};
+	};	// struct thread_cache
+	
+	
+	
+	struct thread_cache_cleaner
+	{
+		inline
+		~thread_cache_cleaner()
+		{
+			thread_cache &c = buffer_pool::thread_cache_();
+			for (std::size_t i = 0; i < size_classes_count; ++i) {
+				buffer_pool::free_blocks_(c.heads_[i]);
+				c.heads_[i] = nullptr;
+				c.sizes_[i] = max_thread_cache_size;	// Blocks released later on thread exit are not cached
+			}
+		}
+	};	// struct thread_cache_cleaner
+	
+	
+	
+	static constexpr std::size_t max_thread_cache_size = static_cast<std::size_t>(-1);
+	
+	
+	
+	virtual
+	void
+	shutdown() override
+	{}
+	
+	
+	static inline
+	thread_cache &
+	thread_cache_() noexcept
+	{
+		static thread_local thread_cache c;
+		return c;
+	}
+	
+	
+	// Registers the cleaner on the first cached block of the thread.
+	static inline
+	void
+	thread_cache_cleaner_() noexcept
+	{
+		static thread_local thread_cache_cleaner cleaner;
+		static_cast<void>(cleaner);
+	}
+	
+	
+	static inline
+	std::size_t
+	size_class_(
+		std::size_t size
+	) noexcept
+	{
+		std::size_t size_class = 0;
+		while ((min_size << size_class) < size)
+			++size_class;
+		return size_class;
+	}
+	
+	
+	static inline
+	void
+	free_blocks_(
+		block *head
+	) noexcept
+	{
+		while (head != nullptr) {
+			block * const next = head->next_;
+			::operator delete(head);
+			head = next;
+		}
+	}
+	
+	
+	inline
+	void
+	release_(
+		void *data,
+		std::size_t capacity
+	) noexcept
+	{
+		if (capacity > max_size) {
+			::operator delete(data);
+			return;
+		}
+		
+		const std::size_t size_class = buffer_pool::size_class_(capacity);
+		block * const block_ptr = ::new (data) block{nullptr};
+		
+		thread_cache &c = buffer_pool::thread_cache_();
+		if (c.sizes_[size_class] < this->parameters_.max_thread_cached) {
+			buffer_pool::thread_cache_cleaner_();
+			block_ptr->next_ = c.heads_[size_class];
+			c.heads_[size_class] = block_ptr;
+			++c.sizes_[size_class];
+			return;
+		}
+		
+		shared_list &list = this->lists_[size_class];
+		{
+			std::lock_guard<std::mutex> lock{list.mutex_};
+			if (list.size_ < this->parameters_.max_cached) {
+				block_ptr->next_ = list.head_;
+				list.head_ = block_ptr;
+				++list.size_;
+				return;
+			}
+		}
+		::operator delete(data);
+	}
+	
+	
+	
+	const parameters parameters_;
+	std::array<shared_list, size_classes_count> lists_;
+	std::atomic<std::size_t> acquired_count_{0}, allocated_count_{0};
+};	// class buffer_pool
+
+
+
+pooled_buffer::~pooled_buffer()
+{
+	this->release();
+}
+
+
+void
+pooled_buffer::release() noexcept
+{
+	if (this->data_ == nullptr)
+		return;
+	
+	this->pool_ptr_->release_(this->data_, this->capacity_);
+	this->pool_ptr_ = nullptr;
+	this->data_ = nullptr;
+	this->size_ = 0;
+	this->capacity_ = 0;
+}
+
+
+};	// namespace dkuk
+
+
+#endif	// DKUK_BUFFER_POOL_HPP
@@ -5,7 +5,7 @@
 // (boost::context::continuation) instead of Boost.Coroutine (which is deprecated). Also, it allows to pass
 // additional arguments to your function (see example 1). Spawned coroutines can be used witout Boost.Asio'a async
 // operations manually (see example 2).
-// See coroutine_future and spawn_with_future() for std::future-like API.
+// See coroutine_future, coroutine_shared_future and spawn_with_future() for std::future-like API.
 // 
 // 
 // Example 1: spawning coroutine with arguments.
@@ -60,20 +60,46 @@
 // }
 // 
 // 
+// Example 3: migrating coroutine between contexts.
+// void handle_request(dkuk::async_core &core, request r, dkuk::coroutine_context context)
+// {
+//     parse(r);                                     // Runs in the lightweight context (where it was spawned)
+//     context.switch_to(core, heavyweight_context); // Suspends and resumes in the heavyweight context
+//     process(r);
+//     context.switch_to(core, lightweight_context);
+//     reply(r);
+// }
+// 
+// 
+// Example 4: awaiting result of another coroutine.
+// void my_fn(dkuk::coroutine_context context)
+// {
+//     dkuk::coroutine_future<int> future = dkuk::spawn_with_future(context, compute);
+//     int res = future.get(context);    // Suspends only this coroutine, future.get() would block the thread
+// }
+// 
+// 
 // Spawn signatures:
 //     spawn(
-//            <strand or io_context or coroutine_context>
+//            <serial_executor or strand or io_context or coroutine_context>
 //         [, std::allocator_arg, stack_alloc [, boost::context::preallocated],]
 //          , <function object with signature: void (Args &&..., coroutine_context)>
 //         [, Args... args]
 //     )
 // 
 // NOTE:
-// - If strand gived, new coroutine will be attached to it. Use this for serialize several coroutines/etc.
-// - If io_context given, new strand will be created.
-// - If coroutine_context given, new strand will be created with given coroutine's io_context.
+// - If serial_executor gived, new coroutine will be attached to it. Use this for serialize several coroutines/etc.
+// - If strand given, new serial_executor will be created over it (see serial_executor).
+// - If io_context given, new serial_executor will be created. Unlike io_context::strand, it never serializes
+//   unrelated coroutines.
+// - If coroutine_context given, new serial_executor will be created with given coroutine's io_context.
 // - Args will be passed as object, not references (like std::thread). See std::ref().
 // - Args and allocators are optional.
+// - spawn_eager() has same signatures, see its description.
+// - get_executor() of coroutine_context and caller returns serial_executor & (it returned io_context::strand &
+//   before). It has the same executor interface (context(), dispatch(), post(), defer(), running_in_this_thread()),
+//   but isn't a strand: spawn coroutine with a strand and use serial_executor::get_strand(), if the strand itself
+//   is needed.
 
 
 #ifndef DKUK_COROUTINE_HPP
@@ -86,20 +112,25 @@
 #include <functional>
 #include <future>
 #include <memory>
+#include <new>
 #include <mutex>
 #include <stdexcept>
 #include <tuple>
 #include <utility>
 
 #include <boost/asio/async_result.hpp>
+#include <boost/asio/executor_work_guard.hpp>
 #include <boost/asio/handler_type.hpp>
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/post.hpp>
-#include <boost/asio/strand.hpp>
+#include <boost/asio/io_context_strand.hpp>
 #include <boost/context/continuation.hpp>
 #include <boost/optional.hpp>
 #include <boost/system/error_code.hpp>
 
+#include <dkuk/buffer_pool.hpp>
+#include <dkuk/serial_executor.hpp>
+
 
 namespace dkuk {
 
@@ -124,7 +155,7 @@ private:
 		template<class Fn, class... Args>
 		inline
 		coro_data(
-			boost::asio::io_context::strand strand,
+			serial_executor executor,
 			Fn &&fn,
 			Args &&... args
 		):
@@ -133,14 +164,14 @@ private:
 					this->wrap_fn(std::forward<Fn>(fn), std::forward<Args>(args)...)
 				)
 			},
-			strand_{std::move(strand)}
+			executor_{std::move(executor)}
 		{}
 		
 		
 		template<class StackAlloc, class Fn, class... Args>
 		inline
 		coro_data(
-			boost::asio::io_context::strand strand,
+			serial_executor executor,
 			std::allocator_arg_t,
 			StackAlloc salloc,
 			Fn &&fn,
@@ -152,14 +183,14 @@ private:
 					this->wrap_fn(std::forward<Fn>(fn), std::forward<Args>(args)...)
 				)
 			},
-			strand_{std::move(strand)}
+			executor_{std::move(executor)}
 		{}
 		
 		
 		template<class StackAlloc, class Fn, class... Args>
 		inline
 		coro_data(
-			boost::asio::io_context::strand strand,
+			serial_executor executor,
 			std::allocator_arg_t,
 			boost::context::preallocated palloc,
 			StackAlloc salloc,
@@ -172,7 +203,7 @@ private:
 					this->wrap_fn(std::forward<Fn>(fn), std::forward<Args>(args)...)
 				)
 			},
-			strand_{std::move(strand)}
+			executor_{std::move(executor)}
 		{}
 		
 		
@@ -199,10 +230,30 @@ private:
 		
 		
 		inline
-		boost::asio::io_context::strand &
-		strand() noexcept
+		serial_executor &
+		executor() noexcept
+		{
+			return this->executor_;
+		}
+		
+		
+		// Pool of the executor's io_context. Cached: lookup of Asio service takes a lock.
+		inline
+		buffer_pool &
+		get_buffer_pool()
+		{
+			if (this->buffer_pool_ptr_ == nullptr)
+				this->buffer_pool_ptr_ = &boost::asio::use_service<buffer_pool>(this->executor_.context());
+			return *this->buffer_pool_ptr_;
+		}
+		
+		
+		// Eager coroutine is started (resumed) inline, if current thread is already inside its executor.
+		inline
+		void
+		set_eager() noexcept
 		{
-			return this->strand_;
+			this->eager_ = true;
 		}
 		
 		
@@ -210,7 +261,21 @@ private:
 		void
 		coro_start()
 		{
-			boost::asio::post(this->strand(), coroutine_context::primitive_caller{this->shared_from_this()});
+			std::size_t &eager_depth = coro_data::eager_depth_();
+			if (this->eager_ && eager_depth < coro_data::max_eager_depth && this->executor().running_in_this_thread()) {
+				++eager_depth;
+				try {
+					this->coro_call();
+				} catch (const std::exception & /* e */) {	// Goes to the executor's runner, as for not eager coroutine
+					this->executor().post(
+						[exception_ptr = std::current_exception()] { std::rethrow_exception(exception_ptr); }
+					);
+				}
+				--eager_depth;
+				return;
+			}
+			
+			this->executor().post(coroutine_context::primitive_caller{this->shared_from_this()});
 		}
 		
 		
@@ -221,11 +286,30 @@ private:
 			if (!this->coro_caller_)
 				throw coroutine_expired{};
 			this->coro_caller_ = this->coro_caller_.resume();
+			if (this->switch_pending_) {	// Continuation is saved, so coroutine can be resumed in another thread
+				this->switch_pending_ = false;
+				this->coro_start();
+				return;	// Coroutine may be running in another thread, or its exception is already rethrown inline
+			}
 			if (this->exception_ptr_)
 				std::rethrow_exception(this->exception_ptr_);
 		}
 		
 		
+		// Rebinds coroutine to the executor and suspends it. Coroutine is resumed in the executor by coro_call().
+		inline
+		void
+		coro_switch(
+			serial_executor executor
+		)
+		{
+			this->executor_ = std::move(executor);
+			this->buffer_pool_ptr_ = nullptr;	// io_context may be changed
+			this->switch_pending_ = true;
+			this->coro_yield();
+		}
+		
+		
 		inline
 		void
 		coro_yield()
@@ -235,6 +319,20 @@ private:
 			*this->coro_execution_context_ptr_ = this->coro_execution_context_ptr_->resume();
 		}
 	private:
+		// Limits nesting of inline starts (each one takes some stack of the current coroutine or thread).
+		static constexpr std::size_t max_eager_depth = 16;
+		
+		
+		
+		static inline
+		std::size_t &
+		eager_depth_() noexcept
+		{
+			static thread_local std::size_t eager_depth = 0;
+			return eager_depth;
+		}
+		
+		
 		template<class Fn, class ArgsTuple, std::size_t... Is>
 		static inline
 		void
@@ -292,8 +390,11 @@ private:
 		
 		
 		boost::context::continuation coro_caller_, *coro_execution_context_ptr_;
-		boost::asio::io_context::strand strand_;
+		serial_executor executor_;
+		buffer_pool *buffer_pool_ptr_ = nullptr;
 		std::exception_ptr exception_ptr_;
+		bool switch_pending_ = false;
+		bool eager_ = false;
 	};	// class coro_data
 	
 	
@@ -372,11 +473,24 @@ public:
 	
 	
 	inline
-	boost::asio::io_context::strand &
+	serial_executor &
 	get_executor() const
 	{
 		const auto coro_data_ptr = this->lock_();
-		return coro_data_ptr->strand();
+		return coro_data_ptr->executor();
+	}
+	
+	
+	// Acquires buffer from the pool of the coroutine's io_context (see buffer_pool). Buffers are recycled, so
+	// per-read allocation costs nothing in steady state.
+	inline
+	pooled_buffer
+	acquire_buffer(
+		std::size_t size
+	) const
+	{
+		const auto coro_data_ptr = this->lock_();
+		return coro_data_ptr->get_buffer_pool().acquire(size);
 	}
 	
 	
@@ -410,6 +524,82 @@ public:
 		res.ec_ptr_ = std::addressof(ec);
 		return res;
 	}
+	
+	
+	// Returns true, if contexts refer to the same coroutine (external error codes are not compared).
+	inline
+	friend
+	bool
+	operator==(
+		const coroutine_context &a,
+		const coroutine_context &b
+	) noexcept
+	{
+		return
+			!a.weak_coro_data_ptr_.owner_before(b.weak_coro_data_ptr_)
+			&& !b.weak_coro_data_ptr_.owner_before(a.weak_coro_data_ptr_);
+	}
+	
+	
+	inline
+	friend
+	bool
+	operator!=(
+		const coroutine_context &a,
+		const coroutine_context &b
+	) noexcept
+	{
+		return !(a == b);
+	}
+	
+	
+	// Migrates coroutine: suspends it and resumes in the executor. Coroutine stays bound to the executor after that
+	// (see get_executor()), so its next async operations are completed there too.
+	// NOTE: Don't call it, while any async operation of the coroutine is pending.
+	inline
+	void
+	switch_to(
+		serial_executor executor
+	) const
+	{
+		const auto raw_coro_data_ptr = this->lock_().get();	// Don't share ownership while suspended!
+		raw_coro_data_ptr->coro_switch(std::move(executor));
+	}
+	
+	
+	// Same as above, but new executor is created over the strand.
+	inline
+	void
+	switch_to(
+		boost::asio::io_context::strand strand
+	) const
+	{
+		this->switch_to(serial_executor{std::move(strand)});
+	}
+	
+	
+	// Same as above, but new executor is created with the io_context.
+	inline
+	void
+	switch_to(
+		boost::asio::io_context &io_context
+	) const
+	{
+		this->switch_to(serial_executor{io_context});
+	}
+	
+	
+	// Same as above, but io_context is taken from the core (e.g. async_core).
+	template<class Core>
+	inline
+	void
+	switch_to(
+		Core &core,
+		typename Core::context_id_type context_id
+	) const
+	{
+		this->switch_to(core.get_io_context(context_id));
+	}
 private:
 	inline
 	coroutine_context(
@@ -465,6 +655,11 @@ private:
 	
 	
 	
+	template<class T>
+	class recycling_allocator;
+	
+	class coroutine_future_state_base;
+	
 	template<class T>
 	class coroutine_future_state;
 	
@@ -479,11 +674,17 @@ private:
 	template<class T>
 	friend class coroutine_future;
 	
+	template<class T>
+	friend class coroutine_shared_future;
+	
 	template<class T>
 	friend class coroutine_promise;
 	
 	template<class... CoroArgs>
-	friend inline void spawn(boost::asio::io_context::strand strand, CoroArgs &&... coro_args);
+	friend inline void spawn(serial_executor executor, CoroArgs &&... coro_args);
+	
+	template<class... CoroArgs>
+	friend inline void spawn_eager(serial_executor executor, CoroArgs &&... coro_args);
 };	// class coroutine_context
 
 
@@ -512,11 +713,8 @@ public:
 		Args &&... args
 	)
 	{
-		if (++this->ready_ == 2) {
-			this->value_ = std::forward_as_tuple(std::forward<Args>(args)...);
-			return true;
-		}
-		return false;
+		this->value_ = std::forward_as_tuple(std::forward<Args>(args)...);	// Before signal: get() may be first
+		return ++this->ready_ == 2;
 	}
 	
 	
@@ -559,11 +757,8 @@ public:
 		Arg &&arg
 	)
 	{
-		if (++this->ready_ == 2) {
-			this->value_ = std::forward<Arg>(arg);
-			return true;
-		}
-		return false;
+		this->value_ = std::forward<Arg>(arg);	// Before signal: get() may be first
+		return ++this->ready_ == 2;
 	}
 	
 	
@@ -603,9 +798,7 @@ public:
 	bool
 	set()
 	{
-		if (++this->ready_ == 2)
-			return true;
-		return false;
+		return ++this->ready_ == 2;
 	}
 	
 	
@@ -648,12 +841,9 @@ public:
 		Args &&... args
 	)
 	{
-		if (++this->ready_ == 2) {
-			this->context_.best_ec_(this->ec_) = std::move(ec);
-			this->value_ = std::forward_as_tuple(std::forward<Args>(args)...);
-			return true;
-		}
-		return false;
+		this->context_.best_ec_(this->ec_) = std::move(ec);	// Before signal: get() may be first
+		this->value_ = std::forward_as_tuple(std::forward<Args>(args)...);
+		return ++this->ready_ == 2;
 	}
 	
 	
@@ -700,12 +890,9 @@ public:
 		Arg &&arg
 	)
 	{
-		if (++this->ready_ == 2) {
-			this->context_.best_ec_(this->ec_) = std::move(ec);
-			this->value_ = std::forward<Arg>(arg);
-			return true;
-		}
-		return false;
+		this->context_.best_ec_(this->ec_) = std::move(ec);	// Before signal: get() may be first
+		this->value_ = std::forward<Arg>(arg);
+		return ++this->ready_ == 2;
 	}
 	
 	
@@ -750,11 +937,8 @@ public:
 		boost::system::error_code ec
 	)
 	{
-		if (++this->ready_ == 2) {
-			this->context_.best_ec_(this->ec_) = std::move(ec);
-			return true;
-		}
-		return false;
+		this->context_.best_ec_(this->ec_) = std::move(ec);	// Before signal: get() may be first
+		return ++this->ready_ == 2;
 	}
 	
 	
@@ -787,7 +971,8 @@ public:
 	caller(
 		const coroutine_context &c
 	):
-		coro_data_ptr_{c.lock_()}
+		coro_data_ptr_{c.lock_()},
+		ec_ptr_{c.ec_ptr_}
 	{}
 	
 	
@@ -797,7 +982,8 @@ public:
 		value_type &value
 	):
 		coro_data_ptr_{c.lock_()},
-		value_ptr_{std::addressof(value)}
+		value_ptr_{std::addressof(value)},
+		ec_ptr_{c.ec_ptr_}
 	{}
 	
 	
@@ -824,18 +1010,21 @@ public:
 	
 	
 	inline
-	boost::asio::io_context::strand &
+	serial_executor &
 	get_executor() const noexcept
 	{
-		return this->coro_data_ptr_->strand();
+		return this->coro_data_ptr_->executor();
 	}
 	
 	
+	// Context keeps external error code (see coroutine_context::operator[]).
 	inline
 	coroutine_context
 	get_context() const noexcept
 	{
-		return this->coro_data_ptr_;
+		coroutine_context res{this->coro_data_ptr_};
+		res.ec_ptr_ = this->ec_ptr_;
+		return res;
 	}
 	
 	
@@ -864,173 +1053,161 @@ public:
 private:
 	std::shared_ptr<coroutine_context::coro_data> coro_data_ptr_;
 	value_type *value_ptr_ = nullptr;
+	boost::system::error_code *ec_ptr_ = nullptr;
 };	// class coroutine_context::caller
 
 
 
+// Allocator, which recycles freed blocks through per-thread cache. Used by default for future states, which are
+// created and destroyed at request rate.
+// NOTE: Blocks freed by another thread go to that thread's cache, not to the allocating one: allocator stays
+//       lock-free, and each thread caches at most max_cached blocks of each type, but producer-consumer patterns
+//       (one thread creates states, another one frees them) get no recycling at all.
 template<class T>
-class coroutine_context::coroutine_future_state
+class coroutine_context::recycling_allocator
 {
 public:
+	using value_type = T;
+	
+	
+	static constexpr std::size_t max_cached = 64;	// Per thread and type
+	
+	
+	
+	recycling_allocator() noexcept = default;
+	
+	
+	template<class U>
 	inline
-	coroutine_future_state(
-		boost::asio::io_context &io_context
-	) noexcept:
-		io_context_ptr_{&io_context},
-		ready_{false}
+	recycling_allocator(
+		const recycling_allocator<U> & /* other */
+	) noexcept
 	{}
 	
 	
 	inline
-	bool
-	ready() const
+	T *
+	allocate(
+		std::size_t n
+	)
 	{
-		return this->ready_;
+		if (n == 1) {
+			cache &c = recycling_allocator::cache_();
+			if (c.head_ != nullptr) {
+				block * const block_ptr = c.head_;
+				c.head_ = block_ptr->next_;
+				--c.size_;
+				return reinterpret_cast<T *>(block_ptr);
+			}
+		}
+		return static_cast<T *>(::operator new(n * sizeof(T)));
 	}
 	
 	
-	template<class T1>
 	inline
 	void
-	set_value(T1 &&value)
+	deallocate(
+		T *ptr,
+		std::size_t n
+	) noexcept
 	{
-		std::unique_lock<std::mutex> lock{this->mutex_};
-		if (this->ready())
-			throw std::future_error{std::future_errc::promise_already_satisfied};
-		
-		this->value_.emplace(std::forward<T1>(value));
-		this->notify_ready_();
+		if (n == 1) {
+			cache &c = recycling_allocator::cache_();
+			if (c.size_ < max_cached) {
+				recycling_allocator::cache_cleaner_();
+				c.head_ = ::new (static_cast<void *>(ptr)) block{c.head_};
+				++c.size_;
+				return;
+			}
+		}
+		::operator delete(ptr);
 	}
 	
 	
+	template<class U>
 	inline
-	void
-	set_exception(
-		std::exception_ptr exception_ptr
-	)
+	bool
+	operator==(
+		const recycling_allocator<U> & /* other */
+	) const noexcept
 	{
-		std::lock_guard<std::mutex> lock{this->mutex_};
-		if (this->ready())
-			throw std::future_error{std::future_errc::promise_already_satisfied};
-		
-		this->exception_ptr_ = std::move(exception_ptr);
-		this->notify_ready_();
+		return true;
 	}
 	
 	
+	template<class U>
 	inline
-	T
-	get()
+	bool
+	operator!=(
+		const recycling_allocator<U> & /* other */
+	) const noexcept
 	{
-		this->wait();
-		if (this->exception_ptr_ != nullptr)
-			std::rethrow_exception(this->exception_ptr_);
-		return this->value_.get();
+		return false;
 	}
+private:
+	struct block
+	{
+		block *next_;
+	};	// struct block
 	
+	static_assert(sizeof(T) >= sizeof(block) && alignof(T) >= alignof(block), "Too small type for recycling");
 	
-	inline
-	void
-	wait()
-	{
-		std::mutex mutex;
-		std::unique_lock<std::mutex> lock{mutex};
-		this->ready_condition_.wait(
-			lock,
-			[&ready = this->ready_]() noexcept -> bool { return ready; }
-		);
-	}
 	
 	
-	template<class Rep, class Period>
-	inline
-	std::future_status
-	wait_for(
-		const std::chrono::duration<Rep, Period> &timeout_duration
-	)
+	// Trivially destructible, so it stays valid during the whole thread exit: other thread_local objects may free
+	// blocks after the cleaner. (Stores to object in its own destructor may be eliminated by compiler.)
+	struct cache
 	{
-		std::mutex mutex;
-		std::unique_lock<std::mutex> lock{mutex};
-		bool ready =
-			this->ready_condition_.wait_for(
-				lock,
-				timeout_duration,
-				[&ready = this->ready_]() noexcept -> bool { return ready; }
-			);
-		return (ready)? std::future_status::ready: std::future_status::timeout;
-	}
+		block *head_ = nullptr;
+		std::size_t size_ = 0;
+	};	// struct cache
 	
 	
-	template<class Clock, class Duration>
-	inline
-	std::future_status
-	wait_until(
-		const std::chrono::time_point<Clock, Duration> &timeout_time
-	)
+	
+	struct cache_cleaner
 	{
-		std::mutex mutex;
-		std::unique_lock<std::mutex> lock{mutex};
-		bool ready =
-			this->ready_condition_.wait_for(
-				lock,
-				timeout_time,
-				[&ready = this->ready_]() noexcept -> bool { return ready; }
-			);
-		return (ready)? std::future_status::ready: std::future_status::timeout;
-	}
+		inline
+		~cache_cleaner()
+		{
+			cache &c = recycling_allocator::cache_();
+			while (c.head_ != nullptr) {
+				block * const next = c.head_->next_;
+				::operator delete(c.head_);
+				c.head_ = next;
+			}
+			c.size_ = max_cached;	// Blocks freed later on thread exit are not cached
+		}
+	};	// struct cache_cleaner
 	
 	
-	template<class Handler>
-	inline
-	typename boost::asio::async_result<Handler, void ()>::result_type
-	async_wait(
-		Handler &&handler
-	)
+	
+	static inline
+	cache &
+	cache_() noexcept
 	{
-		boost::asio::async_completion<Handler, void ()> init{handler};
-		std::unique_lock<std::mutex> lock{this->mutex_};
-		if (this->ready()) {
-			lock.unlock();
-			boost::asio::post(*this->io_context_ptr_, std::move(init.completion_handler));
-		} else {
-			this->handlers_.emplace_back(std::move(init.completion_handler));
-		}
-		return init.result.get();
+		static thread_local cache c;
+		return c;
 	}
-private:
-	inline
+	
+	
+	// Registers the cleaner on the first cached block of the thread.
+	static inline
 	void
-	notify_ready_()
+	cache_cleaner_() noexcept
 	{
-		this->ready_.store(true, std::memory_order_release);
-		
-		this->ready_condition_.notify_all();
-		
-		for (auto &handler: this->handlers_)
-			boost::asio::post(*this->io_context_ptr_, std::move(handler));
-		this->handlers_.clear();
-		this->handlers_.shrink_to_fit();
+		static thread_local cache_cleaner cleaner;
+		static_cast<void>(cleaner);
 	}
-	
-	
-	
-	boost::asio::io_context *io_context_ptr_;
-	std::mutex mutex_;
-	std::condition_variable ready_condition_;
-	std::vector<std::function<void ()>> handlers_;
-	std::atomic<bool> ready_;
-	boost::optional<T> value_;
-	std::exception_ptr exception_ptr_;
-};	// class coroutine_context::coroutine_future_state
+};	// class coroutine_context::recycling_allocator
 
 
 
-template<class T>
-class coroutine_context::coroutine_future_state<T &>
+// Common part of coroutine_future_state specializations: readiness, exception and waiting.
+class coroutine_context::coroutine_future_state_base
 {
 public:
 	inline
-	coroutine_future_state(
+	coroutine_future_state_base(
 		boost::asio::io_context &io_context
 	) noexcept:
 		io_context_ptr_{&io_context},
@@ -1048,14 +1225,10 @@ public:
 	
 	inline
 	void
-	set_value(T &value)
+	retrieve_future()
 	{
-		std::unique_lock<std::mutex> lock{this->mutex_};
-		if (this->ready())
-			throw std::future_error{std::future_errc::promise_already_satisfied};
-		
-		this->value_ptr_ = std::addressof(value);
-		this->notify_ready_();
+		if (this->future_retrieved_.exchange(true))
+			throw std::future_error{std::future_errc::future_already_retrieved};
 	}
 	
 	
@@ -1065,35 +1238,44 @@ public:
 		std::exception_ptr exception_ptr
 	)
 	{
-		std::lock_guard<std::mutex> lock{this->mutex_};
-		if (this->ready())
-			throw std::future_error{std::future_errc::promise_already_satisfied};
-		this->exception_ptr_ = std::move(exception_ptr);
-		this->notify_ready_();
+		this->set_ready_([&] { this->exception_ptr_ = std::move(exception_ptr); });
 	}
 	
 	
 	inline
-	T &
-	get()
+	void
+	wait()
 	{
-		this->wait();
-		if (this->exception_ptr_ != nullptr)
-			std::rethrow_exception(this->exception_ptr_);
-		return *this->value_ptr_;
+		this->blocking_wait_(
+			[](std::condition_variable &condition, std::unique_lock<std::mutex> &lock, const auto &ready) -> bool
+			{
+				condition.wait(lock, ready);
+				return true;
+			}
+		);
 	}
 	
 	
+	// Suspends only the calling coroutine (not the thread), resumes it through its executor.
 	inline
 	void
-	wait()
+	wait(
+		const coroutine_context &context
+	)
 	{
-		std::mutex mutex;
-		std::unique_lock<std::mutex> lock{mutex};
-		this->ready_condition_.wait(
-			lock,
-			[&ready = this->ready_]() noexcept -> bool { return ready; }
-		);
+		if (this->ready())
+			return;
+		
+		// Promise may be satisfied from another thread, so io_context should not run out of work meanwhile
+		const auto work_guard = boost::asio::make_work_guard(context.get_executor().context());
+		coroutine_context::value<> value{context};
+		{
+			std::lock_guard<std::mutex> lock{this->mutex_};
+			if (this->ready())
+				return;
+			this->resumers_.push_back(context.get_caller(value));
+		}
+		value.get();
 	}
 	
 	
@@ -1104,13 +1286,16 @@ public:
 		const std::chrono::duration<Rep, Period> &timeout_duration
 	)
 	{
-		std::mutex mutex;
-		std::unique_lock<std::mutex> lock{mutex};
-		bool ready =
-			this->ready_condition_.wait_for(
-				lock,
-				timeout_duration,
-				[&ready = this->ready_]() noexcept -> bool { return ready; }
+		const bool ready =
+			this->blocking_wait_(
+				[&timeout_duration](
+					std::condition_variable &condition,
+					std::unique_lock<std::mutex> &lock,
+					const auto &ready
+				) -> bool
+				{
+					return condition.wait_for(lock, timeout_duration, ready);
+				}
 			);
 		return (ready)? std::future_status::ready: std::future_status::timeout;
 	}
@@ -1123,13 +1308,16 @@ public:
 		const std::chrono::time_point<Clock, Duration> &timeout_time
 	)
 	{
-		std::mutex mutex;
-		std::unique_lock<std::mutex> lock{mutex};
-		bool ready =
-			this->ready_condition_.wait_for(
-				lock,
-				timeout_time,
-				[&ready = this->ready_]() noexcept -> bool { return ready; }
+		const bool ready =
+			this->blocking_wait_(
+				[&timeout_time](
+					std::condition_variable &condition,
+					std::unique_lock<std::mutex> &lock,
+					const auto &ready
+				) -> bool
+				{
+					return condition.wait_until(lock, timeout_time, ready);
+				}
 			);
 		return (ready)? std::future_status::ready: std::future_status::timeout;
 	}
@@ -1152,186 +1340,284 @@ public:
 		}
 		return init.result.get();
 	}
-private:
+protected:
+	// Stores result (by set fn) and notifies all waiters. Suspended coroutines are resumed directly, after unlocking.
+	template<class Fn>
 	inline
 	void
-	notify_ready_()
+	set_ready_(
+		Fn &&set
+	)
+	{
+		std::vector<coroutine_context::caller<>> resumers;
+		bool has_waiters;
+		{
+			std::lock_guard<std::mutex> lock{this->mutex_};
+			if (this->ready())
+				throw std::future_error{std::future_errc::promise_already_satisfied};
+			
+			set();
+			this->ready_.store(true, std::memory_order_release);
+			has_waiters = (this->waiters_count_ != 0);	// Then condition exists and is not reset
+			
+			for (auto &handler: this->handlers_)
+				boost::asio::post(*this->io_context_ptr_, std::move(handler));
+			this->handlers_.clear();
+			this->handlers_.shrink_to_fit();
+			
+			resumers.swap(this->resumers_);
+		}
+		
+		if (has_waiters)	// Nobody blocks on most of states, so they never touch the kernel
+			this->ready_condition_ptr_->notify_all();
+		
+		for (const auto &resumer: resumers)
+			resumer();
+	}
+	
+	
+	inline
+	void
+	rethrow_if_exception_() const
+	{
+		if (this->exception_ptr_ != nullptr)
+			std::rethrow_exception(this->exception_ptr_);
+	}
+private:
+	// Blocks the thread. Waiters use the state mutex, so notification can't be lost between check and wait.
+	// Condition variable is allocated by the first blocked thread: most of states are never waited this way.
+	// Wait signature: bool (std::condition_variable &, std::unique_lock<std::mutex> &, predicate), returns true,
+	// if the state is ready.
+	template<class Wait>
+	inline
+	bool
+	blocking_wait_(
+		Wait &&wait
+	)
 	{
-		this->ready_.store(true, std::memory_order_release);
+		if (this->ready())
+			return true;
 		
-		this->ready_condition_.notify_all();
+		std::unique_lock<std::mutex> lock{this->mutex_};
+		if (this->ready_condition_ptr_ == nullptr)
+			this->ready_condition_ptr_.reset(new std::condition_variable{});
 		
-		for (auto &handler: this->handlers_)
-			boost::asio::post(*this->io_context_ptr_, std::move(handler));
-		this->handlers_.clear();
-		this->handlers_.shrink_to_fit();
+		++this->waiters_count_;
+		try {
+			const bool ready =
+				wait(*this->ready_condition_ptr_, lock, [this]() noexcept -> bool { return this->ready(); });
+			--this->waiters_count_;
+			return ready;
+		} catch (...) {
+			--this->waiters_count_;
+			throw;
+		}
 	}
 	
 	
 	
 	boost::asio::io_context *io_context_ptr_;
 	std::mutex mutex_;
-	std::condition_variable ready_condition_;
+	std::unique_ptr<std::condition_variable> ready_condition_ptr_;
+	std::size_t waiters_count_ = 0;	// Threads, blocked in wait*()
 	std::vector<std::function<void ()>> handlers_;
+	std::vector<coroutine_context::caller<>> resumers_;
 	std::atomic<bool> ready_;
-	T * value_ptr_;
+	std::atomic<bool> future_retrieved_{false};
 	std::exception_ptr exception_ptr_;
-};	// class coroutine_context::coroutine_future_state<T &>
+};	// class coroutine_context::coroutine_future_state_base
 
 
 
-template<>
-class coroutine_context::coroutine_future_state<void>
+template<class T>
+class coroutine_context::coroutine_future_state:
+	public coroutine_context::coroutine_future_state_base
 {
 public:
-	inline
-	coroutine_future_state(
-		boost::asio::io_context &io_context
-	) noexcept:
-		io_context_ptr_{&io_context},
-		ready_{false}
-	{}
+	using coroutine_context::coroutine_future_state_base::coroutine_future_state_base;
 	
 	
+	template<class T1>
 	inline
-	bool
-	ready() const
+	void
+	set_value(T1 &&value)
 	{
-		return this->ready_;
+		this->set_ready_([&] { this->value_.emplace(std::forward<T1>(value)); });
 	}
 	
 	
+	// For shared futures
 	inline
-	void
-	set_value()
+	const T &
+	get()
 	{
-		std::unique_lock<std::mutex> lock{this->mutex_};
-		if (this->ready())
-			throw std::future_error{std::future_errc::promise_already_satisfied};
-		
-		this->notify_ready_();
+		this->wait();
+		this->rethrow_if_exception_();
+		return this->value_.get();
 	}
 	
 	
 	inline
-	void
-	set_exception(
-		std::exception_ptr exception_ptr
+	const T &
+	get(
+		const coroutine_context &context
 	)
 	{
-		std::lock_guard<std::mutex> lock{this->mutex_};
-		if (this->ready())
-			throw std::future_error{std::future_errc::promise_already_satisfied};
-		this->exception_ptr_ = std::move(exception_ptr);
-		this->notify_ready_();
+		this->wait(context);
+		this->rethrow_if_exception_();
+		return this->value_.get();
 	}
 	
 	
+	// For unique futures: moves the value out
 	inline
-	void
-	get()
+	T
+	take()
 	{
 		this->wait();
-		if (this->exception_ptr_ != nullptr)
-			std::rethrow_exception(this->exception_ptr_);
+		this->rethrow_if_exception_();
+		return std::move(this->value_.get());
 	}
 	
 	
+	inline
+	T
+	take(
+		const coroutine_context &context
+	)
+	{
+		this->wait(context);
+		this->rethrow_if_exception_();
+		return std::move(this->value_.get());
+	}
+private:
+	boost::optional<T> value_;
+};	// class coroutine_context::coroutine_future_state
+
+
+
+template<class T>
+class coroutine_context::coroutine_future_state<T &>:
+	public coroutine_context::coroutine_future_state_base
+{
+public:
+	using coroutine_context::coroutine_future_state_base::coroutine_future_state_base;
+	
+	
 	inline
 	void
-	wait()
+	set_value(T &value)
 	{
-		std::mutex mutex;
-		std::unique_lock<std::mutex> lock{mutex};
-		this->ready_condition_.wait(
-			lock,
-			[&ready = this->ready_]() noexcept -> bool { return ready; }
-		);
+		this->set_ready_([&] { this->value_ptr_ = std::addressof(value); });
 	}
 	
 	
-	template<class Rep, class Period>
 	inline
-	std::future_status
-	wait_for(
-		const std::chrono::duration<Rep, Period> &timeout_duration
-	)
+	T &
+	get()
 	{
-		std::mutex mutex;
-		std::unique_lock<std::mutex> lock{mutex};
-		bool ready =
-			this->ready_condition_.wait_for(
-				lock,
-				timeout_duration,
-				[&ready = this->ready_]() noexcept -> bool { return ready; }
-			);
-		return (ready)? std::future_status::ready: std::future_status::timeout;
+		this->wait();
+		this->rethrow_if_exception_();
+		return *this->value_ptr_;
 	}
 	
 	
-	template<class Clock, class Duration>
 	inline
-	std::future_status
-	wait_until(
-		const std::chrono::time_point<Clock, Duration> &timeout_time
+	T &
+	get(
+		const coroutine_context &context
 	)
 	{
-		std::mutex mutex;
-		std::unique_lock<std::mutex> lock{mutex};
-		bool ready =
-			this->ready_condition_.wait_for(
-				lock,
-				timeout_time,
-				[&ready = this->ready_]() noexcept -> bool { return ready; }
-			);
-		return (ready)? std::future_status::ready: std::future_status::timeout;
+		this->wait(context);
+		this->rethrow_if_exception_();
+		return *this->value_ptr_;
 	}
 	
 	
-	template<class Handler>
 	inline
-	typename boost::asio::async_result<Handler, void ()>::result_type
-	async_wait(
-		Handler &&handler
+	T &
+	take()
+	{
+		return this->get();
+	}
+	
+	
+	inline
+	T &
+	take(
+		const coroutine_context &context
 	)
 	{
-		boost::asio::async_completion<Handler, void ()> init{handler};
-		std::unique_lock<std::mutex> lock{this->mutex_};
-		if (this->ready()) {
-			lock.unlock();
-			boost::asio::post(*this->io_context_ptr_, std::move(init.completion_handler));
-		} else {
-			this->handlers_.emplace_back(std::move(init.completion_handler));
-		}
-		return init.result.get();
+		return this->get(context);
 	}
 private:
+	T *value_ptr_ = nullptr;
+};	// class coroutine_context::coroutine_future_state<T &>
+
+
+
+template<>
+class coroutine_context::coroutine_future_state<void>:
+	public coroutine_context::coroutine_future_state_base
+{
+public:
+	using coroutine_context::coroutine_future_state_base::coroutine_future_state_base;
+	
+	
 	inline
 	void
-	notify_ready_()
+	set_value()
 	{
-		this->ready_.store(true, std::memory_order_release);
-		
-		this->ready_condition_.notify_all();
-		
-		for (auto &handler: this->handlers_)
-			boost::asio::post(*this->io_context_ptr_, std::move(handler));
-		this->handlers_.clear();
-		this->handlers_.shrink_to_fit();
+		this->set_ready_([] {});
 	}
 	
 	
+	inline
+	void
+	get()
+	{
+		this->wait();
+		this->rethrow_if_exception_();
+	}
 	
-	boost::asio::io_context *io_context_ptr_;
-	std::mutex mutex_;
-	std::condition_variable ready_condition_;
-	std::vector<std::function<void ()>> handlers_;
-	std::atomic<bool> ready_;
-	std::exception_ptr exception_ptr_;
+	
+	inline
+	void
+	get(
+		const coroutine_context &context
+	)
+	{
+		this->wait(context);
+		this->rethrow_if_exception_();
+	}
+	
+	
+	inline
+	void
+	take()
+	{
+		this->get();
+	}
+	
+	
+	inline
+	void
+	take(
+		const coroutine_context &context
+	)
+	{
+		this->get(context);
+	}
 };	// class coroutine_context::coroutine_future_state<void>
 
 
 
+template<class T>
+class coroutine_shared_future;
+
+
+
+// Unique future: move-only, get() moves the value out. See coroutine_shared_future for several consumers.
 template<class T>
 class coroutine_future
 {
@@ -1357,32 +1643,33 @@ public:
 	
 	coroutine_future(
 		const coroutine_future &other
-	) = default;
+	) = delete;
 	
 	
 	coroutine_future &
 	operator=(
 		const coroutine_future &other
-	) = default;
+	) = delete;
 	
 	
+	// NOTE: Future becomes invalid (as after get()).
 	inline
 	std::future<T>
 	get_std_future()
 	{
-		const std::shared_ptr<coroutine_context::coroutine_future_state<T>> state_ptr = this->state_ptr_;
+		const std::shared_ptr<coroutine_context::coroutine_future_state<T>> state_ptr = std::move(this->state_ptr_);
 		if (state_ptr == nullptr)
 			return std::future<T>{};
 		
-		std::promise<T> promise;
-		std::future<T> future = promise.get_future();
-		this->async_wait(
-			[state_ptr = std::move(state_ptr), promise = std::move(promise)]
+		const auto promise_ptr = std::make_shared<std::promise<T>>();
+		std::future<T> future = promise_ptr->get_future();
+		state_ptr->async_wait(
+			[state_ptr, promise_ptr]
 			{
 				try {
-					promise.set_value(state_ptr->get());
+					coroutine_future::set_std_promise_(*promise_ptr, *state_ptr);
 				} catch (const std::exception & /* e */) {
-					promise.set_exception(std::current_exception());
+					promise_ptr->set_exception(std::current_exception());
 				}
 			}
 		);
@@ -1390,6 +1677,15 @@ public:
 	}
 	
 	
+	// Allows several consumers to get the result. Future becomes invalid.
+	inline
+	coroutine_shared_future<T>
+	share() noexcept
+	{
+		return coroutine_shared_future<T>{*this->io_context_ptr_, std::move(this->state_ptr_)};
+	}
+	
+	
 	inline
 	bool
 	ready() const
@@ -1401,14 +1697,30 @@ public:
 	}
 	
 	
+	// Moves the value out (no copies of large results), so the future becomes invalid (as std::future).
 	inline
 	auto
-	get() const
+	get()
 		-> decltype(auto)
 	{
-		coroutine_context::coroutine_future_state<T> * const state_ptr = this->state_ptr_.get();
+		const std::shared_ptr<coroutine_context::coroutine_future_state<T>> state_ptr = std::move(this->state_ptr_);
 		if (state_ptr != nullptr)
-			return state_ptr->get();
+			return state_ptr->take();
+		throw std::future_error{std::future_errc::no_state};
+	}
+	
+	
+	// Suspends only the calling coroutine (worker thread continues to execute other handlers).
+	inline
+	auto
+	get(
+		const coroutine_context &context
+	)
+		-> decltype(auto)
+	{
+		const std::shared_ptr<coroutine_context::coroutine_future_state<T>> state_ptr = std::move(this->state_ptr_);
+		if (state_ptr != nullptr)
+			return state_ptr->take(context);
 		throw std::future_error{std::future_errc::no_state};
 	}
 	
@@ -1432,6 +1744,20 @@ public:
 	}
 	
 	
+	// Suspends only the calling coroutine (worker thread continues to execute other handlers).
+	inline
+	void
+	wait(
+		const coroutine_context &context
+	) const
+	{
+		coroutine_context::coroutine_future_state<T> * const state_ptr = this->state_ptr_.get();
+		if (state_ptr != nullptr)
+			return state_ptr->wait(context);
+		throw std::future_error{std::future_errc::no_state};
+	}
+	
+	
 	template<class Rep, class Period>
 	inline
 	std::future_status
@@ -1478,6 +1804,30 @@ private:
 	
 	
 	
+	template<class T1>
+	static inline
+	void
+	set_std_promise_(
+		std::promise<T1> &promise,
+		coroutine_context::coroutine_future_state<T1> &state
+	)
+	{
+		promise.set_value(state.take());
+	}
+	
+	
+	static inline
+	void
+	set_std_promise_(
+		std::promise<void> &promise,
+		coroutine_context::coroutine_future_state<void> &state
+	)
+	{
+		state.take();
+		promise.set_value();
+	}
+	
+	
 	inline
 	coroutine_future(
 		boost::asio::io_context &io_context,
@@ -1495,6 +1845,176 @@ private:
 
 
 
+// Copyable future, which allows several consumers to get the same result. See coroutine_future::share().
+template<class T>
+class coroutine_shared_future
+{
+public:
+	inline
+	coroutine_shared_future(
+		boost::asio::io_context &io_context
+	) noexcept:
+		io_context_ptr_{&io_context}
+	{}
+	
+	
+	coroutine_shared_future(
+		coroutine_shared_future &&other
+	) = default;
+	
+	
+	coroutine_shared_future &
+	operator=(
+		coroutine_shared_future &&other
+	) = default;
+	
+	
+	coroutine_shared_future(
+		const coroutine_shared_future &other
+	) = default;
+	
+	
+	coroutine_shared_future &
+	operator=(
+		const coroutine_shared_future &other
+	) = default;
+	
+	
+	inline
+	bool
+	ready() const
+	{
+		coroutine_context::coroutine_future_state<T> * const state_ptr = this->state_ptr_.get();
+		if (state_ptr != nullptr)
+			return state_ptr->ready();
+		throw std::future_error{std::future_errc::no_state};
+	}
+	
+	
+	// Returns const reference for T (the value is not copied), T & for T &.
+	inline
+	auto
+	get() const
+		-> decltype(auto)
+	{
+		coroutine_context::coroutine_future_state<T> * const state_ptr = this->state_ptr_.get();
+		if (state_ptr != nullptr)
+			return state_ptr->get();
+		throw std::future_error{std::future_errc::no_state};
+	}
+	
+	
+	// Suspends only the calling coroutine (worker thread continues to execute other handlers).
+	inline
+	auto
+	get(
+		const coroutine_context &context
+	) const
+		-> decltype(auto)
+	{
+		coroutine_context::coroutine_future_state<T> * const state_ptr = this->state_ptr_.get();
+		if (state_ptr != nullptr)
+			return state_ptr->get(context);
+		throw std::future_error{std::future_errc::no_state};
+	}
+	
+	
+	inline
+	bool
+	valid() const noexcept
+	{
+		return (this->state_ptr_ != nullptr)? true: false;
+	}
+	
+	
+	inline
+	void
+	wait() const
+	{
+		coroutine_context::coroutine_future_state<T> * const state_ptr = this->state_ptr_.get();
+		if (state_ptr != nullptr)
+			return state_ptr->wait();
+		throw std::future_error{std::future_errc::no_state};
+	}
+	
+	
+	// Suspends only the calling coroutine (worker thread continues to execute other handlers).
+	inline
+	void
+	wait(
+		const coroutine_context &context
+	) const
+	{
+		coroutine_context::coroutine_future_state<T> * const state_ptr = this->state_ptr_.get();
+		if (state_ptr != nullptr)
+			return state_ptr->wait(context);
+		throw std::future_error{std::future_errc::no_state};
+	}
+	
+	
+	template<class Rep, class Period>
+	inline
+	std::future_status
+	wait_for(
+		const std::chrono::duration<Rep, Period> &timeout_duration
+	) const
+	{
+		coroutine_context::coroutine_future_state<T> * const state_ptr = this->state_ptr_.get();
+		if (state_ptr != nullptr)
+			return state_ptr->wait_for(timeout_duration);
+		throw std::future_error{std::future_errc::no_state};
+	}
+	
+	
+	template<class Clock, class Duration>
+	inline
+	std::future_status
+	wait_until(
+		const std::chrono::time_point<Clock, Duration> &timeout_time
+	) const
+	{
+		coroutine_context::coroutine_future_state<T> * const state_ptr = this->state_ptr_.get();
+		if (state_ptr != nullptr)
+			return state_ptr->wait_until(timeout_time);
+		throw std::future_error{std::future_errc::no_state};
+	}
+	
+	
+	template<class Handler>
+	inline
+	typename boost::asio::async_result<Handler, void ()>::result_type
+	async_wait(
+		Handler &&handler
+	) const
+	{
+		coroutine_context::coroutine_future_state<T> * const state_ptr = this->state_ptr_.get();
+		if (state_ptr != nullptr)
+			return state_ptr->async_wait(std::forward<Handler>(handler));
+		throw std::future_error{std::future_errc::no_state};
+	}
+private:
+	template<class T1>
+	friend class coroutine_future;
+	
+	
+	
+	inline
+	coroutine_shared_future(
+		boost::asio::io_context &io_context,
+		std::shared_ptr<coroutine_context::coroutine_future_state<T>> state_ptr
+	) noexcept:
+		io_context_ptr_{&io_context},
+		state_ptr_{std::move(state_ptr)}
+	{}
+	
+	
+	
+	boost::asio::io_context *io_context_ptr_;
+	std::shared_ptr<coroutine_context::coroutine_future_state<T>> state_ptr_;
+};	// class coroutine_shared_future
+
+
+
 template<class T>
 class coroutine_promise
 {
@@ -1504,7 +2024,12 @@ public:
 		boost::asio::io_context &io_context
 	):
 		io_context_ptr_{&io_context},
-		state_ptr_{std::make_shared<coroutine_context::coroutine_future_state<T>>(io_context)}
+		state_ptr_{
+			std::allocate_shared<coroutine_context::coroutine_future_state<T>>(
+				coroutine_context::recycling_allocator<coroutine_context::coroutine_future_state<T>>{},
+				io_context
+			)
+		}
 	{}
 	
 	
@@ -1542,10 +2067,12 @@ public:
 	) = default;
 	
 	
+	// NOTE: Can be called once (futures are unique).
 	inline
 	coroutine_future<T>
-	get_future() const noexcept
+	get_future() const
 	{
+		this->state_ptr_->retrieve_future();
 		return coroutine_future<T>{*this->io_context_ptr_, this->state_ptr_};
 	}
 	
@@ -1603,7 +2130,12 @@ public:
 		boost::asio::io_context &io_context
 	):
 		io_context_ptr_{&io_context},
-		state_ptr_{std::make_shared<coroutine_context::coroutine_future_state<T &>>(io_context)}
+		state_ptr_{
+			std::allocate_shared<coroutine_context::coroutine_future_state<T &>>(
+				coroutine_context::recycling_allocator<coroutine_context::coroutine_future_state<T &>>{},
+				io_context
+			)
+		}
 	{}
 	
 	
@@ -1641,10 +2173,12 @@ public:
 	) = default;
 	
 	
+	// NOTE: Can be called once (futures are unique).
 	inline
 	coroutine_future<T &>
-	get_future() const noexcept
+	get_future() const
 	{
+		this->state_ptr_->retrieve_future();
 		return coroutine_future<T &>{*this->io_context_ptr_, this->state_ptr_};
 	}
 	
@@ -1689,7 +2223,12 @@ public:
 		boost::asio::io_context &io_context
 	):
 		io_context_ptr_{&io_context},
-		state_ptr_{std::make_shared<coroutine_context::coroutine_future_state<void>>(io_context)}
+		state_ptr_{
+			std::allocate_shared<coroutine_context::coroutine_future_state<void>>(
+				coroutine_context::recycling_allocator<coroutine_context::coroutine_future_state<void>>{},
+				io_context
+			)
+		}
 	{}
 	
 	
@@ -1727,10 +2266,12 @@ public:
 	) = default;
 	
 	
+	// NOTE: Can be called once (futures are unique).
 	inline
 	coroutine_future<void>
-	get_future() const noexcept
+	get_future() const
 	{
+		this->state_ptr_->retrieve_future();
 		return coroutine_future<void>{*this->io_context_ptr_, this->state_ptr_};
 	}
 	
@@ -1768,16 +2309,28 @@ template<class... CoroArgs>
 inline
 void
 spawn(
-	boost::asio::io_context::strand strand,
+	serial_executor executor,
 	CoroArgs &&... coro_args
 )
 {
 	coroutine_context::continue_(
-		std::make_shared<coroutine_context::coro_data>(std::move(strand), std::forward<CoroArgs>(coro_args)...)
+		std::make_shared<coroutine_context::coro_data>(std::move(executor), std::forward<CoroArgs>(coro_args)...)
 	);
 }
 
 
+template<class... CoroArgs>
+inline
+void
+spawn(
+	boost::asio::io_context::strand strand,
+	CoroArgs &&... coro_args
+)
+{
+	return spawn(serial_executor{std::move(strand)}, std::forward<CoroArgs>(coro_args)...);
+}
+
+
 template<class... CoroArgs>
 inline
 void
@@ -1786,7 +2339,7 @@ spawn(
 	CoroArgs &&... coro_args
 )
 {
-	return spawn(boost::asio::io_context::strand{io_context}, std::forward<CoroArgs>(coro_args)...);
+	return spawn(serial_executor{io_context}, std::forward<CoroArgs>(coro_args)...);
 }
 
 
@@ -1803,22 +2356,77 @@ spawn(
 
 
 
+// Same as spawn(), but coroutine is started (and resumed by its callers) inline, if current thread is already
+// inside the executor. Saves queue round trip for short coroutines spawned by tasks of the same executor.
+template<class... CoroArgs>
+inline
+void
+spawn_eager(
+	serial_executor executor,
+	CoroArgs &&... coro_args
+)
+{
+	auto coro_data_ptr =
+		std::make_shared<coroutine_context::coro_data>(std::move(executor), std::forward<CoroArgs>(coro_args)...);
+	coro_data_ptr->set_eager();
+	coroutine_context::continue_(std::move(coro_data_ptr));
+}
+
+
+template<class... CoroArgs>
+inline
+void
+spawn_eager(
+	boost::asio::io_context::strand strand,
+	CoroArgs &&... coro_args
+)
+{
+	return spawn_eager(serial_executor{std::move(strand)}, std::forward<CoroArgs>(coro_args)...);
+}
+
+
+template<class... CoroArgs>
+inline
+void
+spawn_eager(
+	boost::asio::io_context &io_context,
+	CoroArgs &&... coro_args
+)
+{
+	return spawn_eager(serial_executor{io_context}, std::forward<CoroArgs>(coro_args)...);
+}
+
+
+// NOTE: Unlike spawn(), new coroutine shares the executor with given one, so it can be started inline.
+template<class... CoroArgs>
+inline
+void
+spawn_eager(
+	const coroutine_context &context,
+	CoroArgs &&... coro_args
+)
+{
+	return spawn_eager(context.get_executor(), std::forward<CoroArgs>(coro_args)...);
+}
+
+
+
 template<class Fn, class... Args>
 inline
 auto
 spawn_with_future(
-	boost::asio::io_context::strand strand,
+	serial_executor executor,
 	Fn &&fn,
 	Args &&... args
 )
 {
 	using result_type = decltype(std::forward<Fn>(fn)(std::move(args)..., std::declval<coroutine_context>()));
 	
-	coroutine_promise<result_type> result_promise{strand.context()};
+	coroutine_promise<result_type> result_promise{executor.context()};
 	coroutine_future<result_type> result_future = result_promise.get_future();
 	
 	spawn(
-		std::move(strand),
+		std::move(executor),
 		
 		[fn = std::forward<Fn>(fn), result_promise = std::move(result_promise)](auto &&... args) mutable
 		{
@@ -1840,7 +2448,7 @@ template<class StackAlloc, class Fn, class... Args>
 inline
 auto
 spawn_with_future(
-	boost::asio::io_context::strand strand,
+	serial_executor executor,
 	std::allocator_arg_t,
 	StackAlloc salloc,
 	Fn &&fn,
@@ -1849,11 +2457,11 @@ spawn_with_future(
 {
 	using result_type = decltype(std::forward<Fn>(fn)(std::move(args)..., std::declval<coroutine_context>()));
 	
-	coroutine_promise<result_type> result_promise{strand.context()};
+	coroutine_promise<result_type> result_promise{executor.context()};
 	coroutine_future<result_type> result_future = result_promise.get_future();
 	
 	spawn(
-		std::move(strand),
+		std::move(executor),
 		
 		std::allocator_arg,
 		std::move(salloc),
@@ -1878,7 +2486,7 @@ template<class StackAlloc, class Fn, class... Args>
 inline
 auto
 spawn_with_future(
-	boost::asio::io_context::strand strand,
+	serial_executor executor,
 	std::allocator_arg_t,
 	boost::context::preallocated palloc,
 	StackAlloc salloc,
@@ -1888,11 +2496,11 @@ spawn_with_future(
 {
 	using result_type = decltype(std::forward<Fn>(fn)(std::move(args)..., std::declval<coroutine_context>()));
 	
-	coroutine_promise<result_type> result_promise{strand.context()};
+	coroutine_promise<result_type> result_promise{executor.context()};
 	coroutine_future<result_type> result_future = result_promise.get_future();
 	
 	spawn(
-		std::move(strand),
+		std::move(executor),
 		
 		std::allocator_arg,
 		std::move(palloc),
@@ -1914,6 +2522,18 @@ spawn_with_future(
 }
 
 
+template<class... CoroArgs>
+inline
+auto
+spawn_with_future(
+	boost::asio::io_context::strand strand,
+	CoroArgs &&... coro_args
+)
+{
+	return spawn_with_future(serial_executor{std::move(strand)}, std::forward<CoroArgs>(coro_args)...);
+}
+
+
 template<class... CoroArgs>
 inline
 auto
@@ -1922,7 +2542,7 @@ spawn_with_future(
 	CoroArgs &&... coro_args
 )
 {
-	return spawn_with_future(boost::asio::io_context::strand{io_context}, std::forward<CoroArgs>(coro_args)...);
+	return spawn_with_future(serial_executor{io_context}, std::forward<CoroArgs>(coro_args)...);
 }
 
 
@@ -1966,6 +2586,33 @@ run_until_complete(
 }
 
 
+template<class T, class Rep, class Period>
+inline
+coroutine_shared_future<T>
+run_until_complete(
+	boost::asio::io_context &io_context,
+	coroutine_shared_future<T> result_future,
+	std::chrono::duration<Rep, Period> timeout_duration
+)
+{
+	while (!result_future.ready())
+		io_context.run_one_for(timeout_duration);
+	return result_future;
+}
+
+
+template<class T>
+inline
+coroutine_shared_future<T>
+run_until_complete(
+	boost::asio::io_context &io_context,
+	coroutine_shared_future<T> result_future
+)
+{
+	return run_until_complete(io_context, std::move(result_future), std::chrono::seconds{1});
+}
+
+
 
 namespace spawn_impl {
 
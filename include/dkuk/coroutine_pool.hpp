@@ -0,0 +1,217 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 06:28
+
+
+// Pool of coroutines, which execute posted function objects. Coroutines are created once and parked, while they
+// have nothing to do, so each posted task costs a queue push and a context switch instead of new coroutine (stack
+// allocation, new executor, etc.). Tasks can suspend on async operations as usual coroutines do.
+//
+// Usage:
+// dkuk::coroutine_pool pool{core, context_id, 16};	// Or: pool{io_context, 16}
+// pool.post(
+//     [](dkuk::coroutine_context context)
+//     {
+//         boost::asio::system_timer timer{context.get_executor().context(), std::chrono::seconds{1}};
+//         timer.async_wait(context);
+//     }
+// );
+//
+// NOTE: Each coroutine has its own executor, so tasks are executed in parallel, if io_context is run by several
+//       threads. At most pool size tasks are executed at once, others wait in the queue.
+// NOTE: Exceptions thrown by tasks are rethrown from io_context's run() (as for spawned coroutines), but
+//       coroutines of the pool survive them.
+// NOTE: Tasks, which are not started before pool destruction, are destroyed without execution. Started tasks are
+//       finished as usual.
+//
+// Thread-safety:
+// - coroutine_pool:
+//     + distinct objects: safe;
+//     + shared object: safe.
+
+
+#ifndef DKUK_COROUTINE_POOL_HPP
+#define DKUK_COROUTINE_POOL_HPP
+
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+
+#include <dkuk/coroutine.hpp>
+#include <dkuk/detail/function_node.hpp>
+
+
+namespace dkuk {
+
+
+class coroutine_pool
+{
+public:
+	coroutine_pool(
+		boost::asio::io_context &io_context,
+		std::size_t size
+	):
+		state_ptr_{std::make_shared<state>(io_context)}
+	{
+		if (size == 0)
+			throw std::invalid_argument{"Empty coroutine pool"};
+		
+		for (std::size_t i = 0; i < size; ++i)
+			spawn(io_context, &coroutine_pool::coroutine_run_, this->state_ptr_);
+	}
+	
+	
+	// Coroutines run in the context of the core (e.g. async_core).
+	template<class Core>
+	coroutine_pool(
+		Core &core,
+		typename Core::context_id_type context_id,
+		std::size_t size
+	):
+		coroutine_pool{core.get_io_context(context_id), size}
+	{}
+	
+	
+	coroutine_pool(
+		const coroutine_pool &other
+	) = delete;
+	
+	
+	coroutine_pool &
+	operator=(
+		const coroutine_pool &other
+	) = delete;
+	
+	
+	inline
+	~coroutine_pool()
+	{
+		std::vector<coroutine_context::caller<>> idle_callers;
+		std::deque<task_ptr_type> pending_task_ptrs;
+		{
+			std::lock_guard<std::mutex> lock{this->state_ptr_->mutex_};
+			this->state_ptr_->stopping_ = true;
+			idle_callers.swap(this->state_ptr_->idle_callers_);
+			pending_task_ptrs.swap(this->state_ptr_->pending_task_ptrs_);
+		}
+		
+		for (const auto &caller: idle_callers)	// Let parked coroutines finish
+			caller();
+	}
+	
+	
+	// Fn signature: void (coroutine_context).
+	template<class Fn>
+	void
+	post(
+		Fn &&fn
+	)
+	{
+		task_ptr_type task_ptr = task::make(std::forward<Fn>(fn));
+		
+		std::unique_lock<std::mutex> lock{this->state_ptr_->mutex_};
+		if (this->state_ptr_->idle_callers_.empty()) {
+			this->state_ptr_->pending_task_ptrs_.push_back(std::move(task_ptr));
+			return;
+		}
+		
+		// Hand the task to parked coroutine and resume it
+		const coroutine_context::caller<> caller = std::move(this->state_ptr_->idle_callers_.back());
+		this->state_ptr_->idle_callers_.pop_back();
+		*this->state_ptr_->handed_task_ptr_ptrs_.back() = std::move(task_ptr);
+		this->state_ptr_->handed_task_ptr_ptrs_.pop_back();
+		lock.unlock();
+		
+		caller();
+	}
+	
+	
+	inline
+	boost::asio::io_context &
+	get_io_context() const noexcept
+	{
+		return this->state_ptr_->io_context_;
+	}
+private:
+	using task = detail::function_node<void(coroutine_context)>;
+	using task_ptr_type = std::unique_ptr<task>;
+	
+	
+	
+	// Pool's coroutines keep it: they finish after the pool is destroyed (io_context may run them later).
+	struct state
+	{
+		explicit
+		state(
+			boost::asio::io_context &io_context
+		) noexcept:
+			io_context_{io_context}
+		{}
+		
+		
+		
+		boost::asio::io_context &io_context_;
+		std::mutex mutex_;
+		std::vector<coroutine_context::caller<>> idle_callers_;
+		std::vector<task_ptr_type *> handed_task_ptr_ptrs_;	// Where to put task for idle coroutine (same order)
+		std::deque<task_ptr_type> pending_task_ptrs_;
+		bool stopping_ = false;
+	};	// struct state
+	
+	
+	
+	static
+	void
+	coroutine_run_(
+		const std::shared_ptr<state> &state_ptr,
+		coroutine_context context
+	)
+	{
+		while (true) {
+			task_ptr_type task_ptr;
+			{
+				std::unique_lock<std::mutex> lock{state_ptr->mutex_};
+				if (state_ptr->stopping_)
+					return;
+				
+				if (!state_ptr->pending_task_ptrs_.empty()) {
+					task_ptr = std::move(state_ptr->pending_task_ptrs_.front());
+					state_ptr->pending_task_ptrs_.pop_front();
+				} else {	// Park until post() hands a task (or the pool is destroyed)
+					coroutine_context::value<> value{context};
+					state_ptr->idle_callers_.push_back(context.get_caller(value));
+					state_ptr->handed_task_ptr_ptrs_.push_back(&task_ptr);
+					lock.unlock();
+					
+					value.get();
+					if (task_ptr == nullptr)	// Stopping
+						return;
+				}
+			}
+			
+			try {
+				(*task_ptr)(context);
+			} catch (const std::exception & /* e */) {	// Goes to the io_context's runner, coroutine continues
+				boost::asio::post(
+					state_ptr->io_context_,
+					[exception_ptr = std::current_exception()] { std::rethrow_exception(exception_ptr); }
+				);
+			}
+		}
+	}
+	
+	
+	
+	std::shared_ptr<state> state_ptr_;
+};	// class coroutine_pool
+
+
+};	// namespace dkuk
+
+
+#endif	// DKUK_COROUTINE_POOL_HPP
@@ -0,0 +1,104 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 09:15
+
+
+// Type-erased function object allocated on heap: queued task, message or handler of the library's queues. Unlike
+// std::function, it allows move-only function objects (e.g. coroutine_promise can't be copied from const object).
+// Hook is an additional base class, so one allocation holds both the function object and queue's data (e.g.
+// mpsc_queue_hook for intrusive queues).
+//
+// Usage:
+// using task = dkuk::detail::function_node<void(int)>;
+//
+// std::unique_ptr<task> task_ptr = task::make([promise = std::move(promise)](int x) mutable { ... });
+// (*task_ptr)(42);
+
+
+#ifndef DKUK_DETAIL_FUNCTION_NODE_HPP
+#define DKUK_DETAIL_FUNCTION_NODE_HPP
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+
+namespace dkuk {
+namespace detail {
+
+
+struct no_hook
+{};	// struct no_hook
+
+
+
+template<class Signature, class Hook = no_hook>
+class function_node;
+
+
+
+template<class Fn, class Signature, class Hook>
+class function_node_impl;
+
+
+
+template<class... Args, class Hook>
+class function_node<void(Args...), Hook>:
+	public Hook
+{
+public:
+	virtual
+	~function_node() = default;
+	
+	
+	virtual
+	void
+	operator()(
+		Args... args
+	) = 0;
+	
+	
+	template<class Fn>
+	static inline
+	std::unique_ptr<function_node>
+	make(
+		Fn &&fn
+	)
+	{
+		using impl_type = function_node_impl<typename std::decay<Fn>::type, void(Args...), Hook>;
+		return std::unique_ptr<function_node>{new impl_type{std::forward<Fn>(fn)}};
+	}
+};	// class function_node
+
+
+
+template<class Fn, class... Args, class Hook>
+class function_node_impl<Fn, void(Args...), Hook> final:
+	public function_node<void(Args...), Hook>
+{
+public:
+	template<class F>
+	explicit
+	function_node_impl(
+		F &&fn
+	):
+		fn_{std::forward<F>(fn)}
+	{}
+	
+	
+	virtual
+	void
+	operator()(
+		Args... args
+	) override
+	{
+		this->fn_(std::forward<Args>(args)...);
+	}
+private:
+	Fn fn_;
+};	// class function_node_impl
+
+
+};	// namespace detail
+};	// namespace dkuk
+
+
+#endif	// DKUK_DETAIL_FUNCTION_NODE_HPP
@@ -0,0 +1,172 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 07:01
+
+
+// Intrusive lock-free multiple-producer single-consumer queue (Dmitry Vyukov's algorithm). Push is one atomic
+// exchange and one store, pop takes no atomic read-modify-write operations at all (except when the queue becomes
+// empty). Queue doesn't own nodes: they are allocated and freed by the user.
+//
+// Usage:
+// struct message: dkuk::mpsc_queue_hook { int value; };
+//
+// dkuk::mpsc_queue<message> q;
+// q.push(new message{...});	// Any thread
+//
+// while (message *m = q.pop()) {	// One thread at a time
+//     process(m->value);
+//     delete m;
+// }
+//
+// NOTE: pop() may return nullptr, while some push() is in progress (even if other nodes are pushed after that one
+//       completely). Use external counter to know, how many nodes should be popped (see actor).
+//
+// Thread-safety:
+// - mpsc_queue:
+//     + distinct objects: safe;
+//     + shared object: push(): safe, pop(): unsafe (one consumer at a time).
+
+
+#ifndef DKUK_MPSC_QUEUE_HPP
+#define DKUK_MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+
+namespace dkuk {
+
+
+// Base class for queue nodes.
+class mpsc_queue_hook
+{
+public:
+	mpsc_queue_hook() noexcept = default;
+	
+	
+	// Copied node is not linked anywhere.
+	inline
+	mpsc_queue_hook(
+		const mpsc_queue_hook & /* other */
+	) noexcept
+	{}
+	
+	
+	inline
+	mpsc_queue_hook &
+	operator=(
+		const mpsc_queue_hook & /* other */
+	) noexcept
+	{
+		return *this;
+	}
+private:
+	template<class Node>
+	friend class mpsc_queue;
+	
+	
+	
+	std::atomic<mpsc_queue_hook *> next_hook_ptr_{nullptr};
+};	// class mpsc_queue_hook
+
+
+
+template<class Node>
+class mpsc_queue
+{
+	static_assert(std::is_base_of<mpsc_queue_hook, Node>::value, "Node should be derived from mpsc_queue_hook");
+public:
+	inline
+	mpsc_queue() noexcept:
+		head_ptr_{&this->stub_},
+		tail_ptr_{&this->stub_}
+	{}
+	
+	
+	mpsc_queue(
+		const mpsc_queue &other
+	) = delete;
+	
+	
+	mpsc_queue &
+	operator=(
+		const mpsc_queue &other
+	) = delete;
+	
+	
+	inline
+	void
+	push(
+		Node *node_ptr
+	) noexcept
+	{
+		this->push_hook_(node_ptr);
+	}
+	
+	
+	// Returns nullptr, if queue is empty (or the oldest push() is not completed yet).
+	inline
+	Node *
+	pop() noexcept
+	{
+		mpsc_queue_hook *tail_ptr = this->tail_ptr_;
+		mpsc_queue_hook *next_ptr = tail_ptr->next_hook_ptr_.load(std::memory_order_acquire);
+		
+		if (tail_ptr == &this->stub_) {	// Skip the stub
+			if (next_ptr == nullptr)
+				return nullptr;
+			this->tail_ptr_ = next_ptr;
+			tail_ptr = next_ptr;
+			next_ptr = next_ptr->next_hook_ptr_.load(std::memory_order_acquire);
+		}
+		
+		if (next_ptr != nullptr) {
+			this->tail_ptr_ = next_ptr;
+			return static_cast<Node *>(tail_ptr);
+		}
+		
+		// Tail is the last node (or some producer is between exchange and link)
+		if (tail_ptr != this->head_ptr_.load(std::memory_order_acquire))
+			return nullptr;
+		
+		this->push_hook_(&this->stub_);	// Tail can't be unlinked without a node after it
+		next_ptr = tail_ptr->next_hook_ptr_.load(std::memory_order_acquire);
+		if (next_ptr != nullptr) {
+			this->tail_ptr_ = next_ptr;
+			return static_cast<Node *>(tail_ptr);
+		}
+		return nullptr;
+	}
+private:
+	inline
+	void
+	push_hook_(
+		mpsc_queue_hook *hook_ptr
+	) noexcept
+	{
+		hook_ptr->next_hook_ptr_.store(nullptr, std::memory_order_relaxed);
+		mpsc_queue_hook * const prev_ptr = this->head_ptr_.exchange(hook_ptr, std::memory_order_acq_rel);
+		prev_ptr->next_hook_ptr_.store(hook_ptr, std::memory_order_release);
+	}
+	
+	
+	
+	static constexpr std::size_t cache_line_size = 64;
+	
+	
+	
+	mpsc_queue_hook stub_;
+	
+	char padding0_[cache_line_size];
+	std::atomic<mpsc_queue_hook *> head_ptr_;	// Producers' side
+	
+	char padding1_[cache_line_size];
+	mpsc_queue_hook *tail_ptr_;	// Consumer's side
+	
+	char padding2_[cache_line_size];
+};	// class mpsc_queue
+
+
+};	// namespace dkuk
+
+
+#endif	// DKUK_MPSC_QUEUE_HPP
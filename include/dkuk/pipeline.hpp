@@ -0,0 +1,662 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 07:05
+
+
+// Staged pipeline (SEDA) over async_core. Each stage gets its own async_core context with its own workers and
+// bounded queue, so slow stage doesn't take workers of other stages, and producers are blocked (backpressure),
+// when stage can't keep up. Items are handed over between stages in batches: one task per batch_size items.
+// Cheap stages (e.g. filters) can be fused with previous ones: they are executed inline, without context, queue
+// and handoff.
+//
+// Usage:
+// dkuk::pipeline<std::string> p =
+//     dkuk::make_pipeline<std::string>(core, parent_context_id)
+//         .stage<record>(
+//             [](std::string &&line, dkuk::pipeline_output<record> &output) { output(parse(line)); },
+//             parse_parameters
+//         )
+//         .stage<record>(
+//             [](record &&r, dkuk::pipeline_output<record> &output) { if (r.level >= warning) output(std::move(r)); },
+//             filter_parameters	// With fuse = true
+//         )
+//         .sink([&](record &&r) { write(r); }, write_parameters);
+//
+// p.push(line);	// Or push_batch(lines)
+// dkuk::pipeline_stage::statistics parse_statistics = p.get_stage_statistics(0);
+//
+// NOTE: Stage function may output any number of items per input item. Output batch is handed over, when it is
+//       full, or when the input batch is processed.
+// NOTE: Exceptions thrown by stage functions are passed to the async_core's exception handler, other items of
+//       the batch are processed as usual.
+// NOTE: Core should outlive the pipeline and all its tasks (stages' contexts are not retired automatically).
+// NOTE: Handoff to bounded stage blocks the previous stage's worker (or parent's worker), so bounded stage should
+//       have its own workers, which never wait for the parent's ones: otherwise std::invalid_argument is thrown.
+//
+// Thread-safety:
+// - pipeline:
+//     + distinct objects: safe;
+//     + shared object: safe.
+// - pipeline_builder:
+//     + distinct objects: safe;
+//     + shared object: unsafe.
+
+
+#ifndef DKUK_PIPELINE_HPP
+#define DKUK_PIPELINE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/asio/post.hpp>
+
+#include <dkuk/async_core.hpp>
+
+
+namespace dkuk {
+
+
+class pipeline_stage
+{
+public:
+	struct parameters
+	{
+		std::size_t workers_count  = 1;	// Non-zero for bounded stage (see above)
+		std::size_t queue_capacity = 0;	// Batches waiting for the stage. Zero: unbounded, otherwise producers block
+		std::size_t batch_size     = 64;	// Items per handoff to the next stage
+		bool        fuse           = false;	// Execute inline in the previous stage (no context, queue and handoff)
+	};	// struct parameters
+	
+	
+	
+	struct statistics
+	{
+		async_core::context_id_type context_id      = 0;	// Context of the previous stage, if fused
+		bool                        fused           = false;
+		std::size_t                 items_in        = 0;
+		std::size_t                 items_out       = 0;
+		std::size_t                 batches_in      = 0;
+		std::size_t                 batches_queued  = 0;	// Waiting in the stage's queue
+		std::chrono::nanoseconds    processing_time = std::chrono::nanoseconds::zero();
+	};	// struct statistics
+};	// class pipeline_stage
+
+
+
+namespace pipeline_impl {
+
+
+template<class T>
+class input
+{
+public:
+	virtual
+	~input() = default;
+	
+	
+	virtual
+	void
+	push_batch(
+		std::vector<T> &&batch
+	) = 0;
+};	// class input
+
+
+
+class statistics_source
+{
+public:
+	virtual
+	~statistics_source() = default;
+	
+	
+	virtual
+	pipeline_stage::statistics
+	get_statistics() const = 0;
+};	// class statistics_source
+
+
+
+// Common part of stages: handoff and metrics.
+template<class In>
+class stage_base:
+	public input<In>,
+	public statistics_source,
+	public std::enable_shared_from_this<stage_base<In>>
+{
+public:
+	inline
+	stage_base(
+		async_core &core,
+		async_core::context_id_type context_id,
+		bool fused
+	) noexcept:
+		core_{core},
+		context_id_{context_id},
+		fused_{fused}
+	{}
+	
+	
+	virtual
+	void
+	push_batch(
+		std::vector<In> &&batch
+	) override
+	{
+		if (batch.empty())
+			return;
+		
+		if (this->fused_) {
+			this->process_(batch);
+			return;
+		}
+		
+		this->batches_queued_.fetch_add(1, std::memory_order_relaxed);	// Before post: process_() may be first
+		try {
+			this->core_.post(
+				this->context_id_,
+				[stage_ptr = this->shared_from_this(), batch = std::move(batch)]() mutable { stage_ptr->process_(batch); }
+			);
+		} catch (...) {
+			this->batches_queued_.fetch_sub(1, std::memory_order_relaxed);
+			throw;
+		}
+	}
+	
+	
+	virtual
+	pipeline_stage::statistics
+	get_statistics() const override
+	{
+		pipeline_stage::statistics statistics;
+		statistics.context_id      = this->context_id_;
+		statistics.fused           = this->fused_;
+		statistics.items_in        = this->items_in_.load(std::memory_order_relaxed);
+		statistics.items_out       = this->items_out_.load(std::memory_order_relaxed);
+		statistics.batches_in      = this->batches_in_.load(std::memory_order_relaxed);
+		statistics.batches_queued  = this->batches_queued_.load(std::memory_order_relaxed);
+		statistics.processing_time = std::chrono::nanoseconds{this->processing_time_.load(std::memory_order_relaxed)};
+		return statistics;
+	}
+protected:
+	virtual
+	void
+	process_batch_(
+		std::vector<In> &batch
+	) = 0;
+	
+	
+	// Exception goes to the core's exception handler, processing continues.
+	inline
+	void
+	handle_exception_()
+	{
+		boost::asio::post(
+			this->core_.get_io_context(this->context_id_),
+			[exception_ptr = std::current_exception()] { std::rethrow_exception(exception_ptr); }
+		);
+	}
+	
+	
+	
+	async_core &core_;
+	const async_core::context_id_type context_id_;
+	const bool fused_;
+	std::atomic<std::size_t> items_out_{0};
+private:
+	void
+	process_(
+		std::vector<In> &batch
+	)
+	{
+		if (!this->fused_)
+			this->batches_queued_.fetch_sub(1, std::memory_order_relaxed);
+		
+		const auto start = std::chrono::steady_clock::now();
+		this->items_in_.fetch_add(batch.size(), std::memory_order_relaxed);
+		this->batches_in_.fetch_add(1, std::memory_order_relaxed);
+		
+		this->process_batch_(batch);
+		
+		this->processing_time_.fetch_add(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count(),
+			std::memory_order_relaxed
+		);
+	}
+	
+	
+	
+	// Handed off, but not processed yet: context's queue statistics don't count tasks of unbounded contexts.
+	std::atomic<std::size_t> items_in_{0}, batches_in_{0}, batches_queued_{0};
+	std::atomic<std::chrono::nanoseconds::rep> processing_time_{0};
+};	// class stage_base
+
+
+
+template<class In, class Out, class Fn>
+class stage;
+
+
+
+template<class In, class Fn>
+class sink;
+
+
+};	// namespace pipeline_impl
+
+
+
+// Output of stage function: collects items to batches for the next stage.
+template<class T>
+class pipeline_output
+{
+public:
+	pipeline_output(
+		const pipeline_output &other
+	) = delete;
+	
+	
+	pipeline_output &
+	operator=(
+		const pipeline_output &other
+	) = delete;
+	
+	
+	inline
+	void
+	operator()(
+		T &&item
+	)
+	{
+		this->batch_.push_back(std::move(item));
+		if (this->batch_.size() >= this->batch_size_)
+			this->flush_();
+	}
+	
+	
+	inline
+	void
+	operator()(
+		const T &item
+	)
+	{
+		this->batch_.push_back(item);
+		if (this->batch_.size() >= this->batch_size_)
+			this->flush_();
+	}
+private:
+	template<class In, class Out, class Fn>
+	friend class pipeline_impl::stage;
+	
+	
+	
+	inline
+	pipeline_output(
+		pipeline_impl::input<T> &next,
+		std::size_t batch_size,
+		std::atomic<std::size_t> &items_out
+	):
+		next_{next},
+		batch_size_{batch_size},
+		items_out_{items_out}
+	{
+		this->batch_.reserve(batch_size);
+	}
+	
+	
+	inline
+	void
+	flush_()
+	{
+		if (this->batch_.empty())
+			return;
+		
+		this->items_out_.fetch_add(this->batch_.size(), std::memory_order_relaxed);
+		this->next_.push_batch(std::move(this->batch_));
+		this->batch_.clear();	// Moved-from vector is valid, but unspecified
+		this->batch_.reserve(this->batch_size_);
+	}
+	
+	
+	
+	pipeline_impl::input<T> &next_;
+	const std::size_t batch_size_;
+	std::atomic<std::size_t> &items_out_;
+	std::vector<T> batch_;
+};	// class pipeline_output
+
+
+
+namespace pipeline_impl {
+
+
+template<class In, class Out, class Fn>
+class stage:
+	public stage_base<In>
+{
+public:
+	inline
+	stage(
+		async_core &core,
+		async_core::context_id_type context_id,
+		const pipeline_stage::parameters &parameters,
+		Fn &&fn
+	):
+		stage_base<In>{core, context_id, parameters.fuse},
+		batch_size_{parameters.batch_size},
+		fn_{std::move(fn)}
+	{}
+	
+	
+	inline
+	void
+	set_next(
+		std::shared_ptr<input<Out>> next_ptr
+	) noexcept
+	{
+		this->next_ptr_ = std::move(next_ptr);
+	}
+protected:
+	virtual
+	void
+	process_batch_(
+		std::vector<In> &batch
+	) override
+	{
+		pipeline_output<Out> output{*this->next_ptr_, this->batch_size_, this->items_out_};
+		for (In &item: batch) {
+			try {
+				this->fn_(std::move(item), output);
+			} catch (const std::exception & /* e */) {
+				this->handle_exception_();
+			}
+		}
+		output.flush_();
+	}
+private:
+	const std::size_t batch_size_;
+	Fn fn_;
+	std::shared_ptr<input<Out>> next_ptr_;
+};	// class stage
+
+
+
+template<class In, class Fn>
+class sink:
+	public stage_base<In>
+{
+public:
+	inline
+	sink(
+		async_core &core,
+		async_core::context_id_type context_id,
+		const pipeline_stage::parameters &parameters,
+		Fn &&fn
+	):
+		stage_base<In>{core, context_id, parameters.fuse},
+		fn_{std::move(fn)}
+	{}
+protected:
+	virtual
+	void
+	process_batch_(
+		std::vector<In> &batch
+	) override
+	{
+		for (In &item: batch) {
+			try {
+				this->fn_(std::move(item));
+			} catch (const std::exception & /* e */) {
+				this->handle_exception_();
+			}
+		}
+	}
+private:
+	Fn fn_;
+};	// class sink
+
+
+};	// namespace pipeline_impl
+
+
+
+template<class In>
+class pipeline
+{
+public:
+	pipeline(
+		pipeline &&other
+	) = default;
+	
+	
+	pipeline &
+	operator=(
+		pipeline &&other
+	) = default;
+	
+	
+	// Blocks, if the first stage's queue is full. Throws context_overflow, if the core is stopping.
+	inline
+	void
+	push(
+		In item
+	)
+	{
+		std::vector<In> batch;
+		batch.push_back(std::move(item));
+		this->head_ptr_->push_batch(std::move(batch));
+	}
+	
+	
+	inline
+	void
+	push_batch(
+		std::vector<In> batch
+	)
+	{
+		this->head_ptr_->push_batch(std::move(batch));
+	}
+	
+	
+	inline
+	std::size_t
+	get_stages_count() const noexcept
+	{
+		return this->stage_ptrs_.size();
+	}
+	
+	
+	inline
+	pipeline_stage::statistics
+	get_stage_statistics(
+		std::size_t stage_index
+	) const
+	{
+		return this->stage_ptrs_.at(stage_index)->get_statistics();
+	}
+private:
+	template<class In1, class Out1>
+	friend class pipeline_builder;
+	
+	
+	
+	inline
+	pipeline(
+		std::shared_ptr<pipeline_impl::input<In>> head_ptr,
+		std::vector<std::shared_ptr<pipeline_impl::statistics_source>> stage_ptrs
+	) noexcept:
+		head_ptr_{std::move(head_ptr)},
+		stage_ptrs_{std::move(stage_ptrs)}
+	{}
+	
+	
+	
+	std::shared_ptr<pipeline_impl::input<In>> head_ptr_;
+	std::vector<std::shared_ptr<pipeline_impl::statistics_source>> stage_ptrs_;
+};	// class pipeline
+
+
+
+// Builds pipeline stage by stage: contexts are added to the core immediately (the core may be running).
+// In: type of pipeline's items, Out: type of the last stage's output.
+template<class In, class Out>
+class pipeline_builder
+{
+public:
+	// Fn signature: void (Out &&item, pipeline_output<NewOut> &output).
+	template<class NewOut, class Fn>
+	pipeline_builder<In, NewOut>
+	stage(
+		Fn &&fn,
+		const pipeline_stage::parameters &parameters = pipeline_stage::parameters{}
+	)
+	{
+		if (parameters.batch_size == 0)
+			throw std::invalid_argument{"Zero pipeline batch size"};
+		
+		using stage_type = pipeline_impl::stage<Out, NewOut, typename std::decay<Fn>::type>;
+		const async_core::context_id_type context_id = this->add_context_(parameters);
+		const auto stage_ptr =
+			std::make_shared<stage_type>(
+				this->core_,
+				context_id,
+				parameters,
+				typename std::decay<Fn>::type{std::forward<Fn>(fn)}
+			);
+		this->connect_tail_(stage_ptr);
+		this->stage_ptrs_.push_back(stage_ptr);
+		
+		return pipeline_builder<In, NewOut>{
+			this->core_,
+			this->parent_id_,
+			context_id,
+			std::move(this->head_ptr_holder_ptr_),
+			[stage_ptr](std::shared_ptr<pipeline_impl::input<NewOut>> next_ptr)
+			{
+				stage_ptr->set_next(std::move(next_ptr));
+			},
+			std::move(this->stage_ptrs_)
+		};
+	}
+	
+	
+	// Fn signature: void (Out &&item).
+	template<class Fn>
+	pipeline<In>
+	sink(
+		Fn &&fn,
+		const pipeline_stage::parameters &parameters = pipeline_stage::parameters{}
+	)
+	{
+		using sink_type = pipeline_impl::sink<Out, typename std::decay<Fn>::type>;
+		const auto sink_ptr =
+			std::make_shared<sink_type>(
+				this->core_,
+				this->add_context_(parameters),
+				parameters,
+				typename std::decay<Fn>::type{std::forward<Fn>(fn)}
+			);
+		this->connect_tail_(sink_ptr);
+		this->stage_ptrs_.push_back(sink_ptr);
+		
+		return pipeline<In>{std::move(*this->head_ptr_holder_ptr_), std::move(this->stage_ptrs_)};
+	}
+private:
+	template<class In1, class Out1>
+	friend class pipeline_builder;
+	
+	template<class In1>
+	friend pipeline_builder<In1, In1> make_pipeline(async_core &core, async_core::context_id_type parent_id);
+	
+	
+	
+	using head_ptr_holder_type = std::shared_ptr<std::shared_ptr<pipeline_impl::input<In>>>;
+	using connector_type = std::function<void (std::shared_ptr<pipeline_impl::input<Out>>)>;
+	
+	
+	
+	inline
+	pipeline_builder(
+		async_core &core,
+		async_core::context_id_type parent_id,
+		async_core::context_id_type last_context_id,
+		head_ptr_holder_type head_ptr_holder_ptr,
+		connector_type connect_tail,
+		std::vector<std::shared_ptr<pipeline_impl::statistics_source>> stage_ptrs
+	):
+		core_{core},
+		parent_id_{parent_id},
+		last_context_id_{last_context_id},
+		head_ptr_holder_ptr_{std::move(head_ptr_holder_ptr)},
+		connect_tail_{std::move(connect_tail)},
+		stage_ptrs_{std::move(stage_ptrs)}
+	{}
+	
+	
+	// Fused stage uses the previous stage's context.
+	inline
+	async_core::context_id_type
+	add_context_(
+		const pipeline_stage::parameters &parameters
+	)
+	{
+		if (parameters.fuse)
+			return this->last_context_id_;
+		
+		if (parameters.queue_capacity != 0 && parameters.workers_count == 0)	// Blocked parent's workers: deadlock
+			throw std::invalid_argument{"Bounded pipeline stage without workers"};
+		
+		async_core::context::parameters context_parameters;
+		context_parameters.capacity        = parameters.queue_capacity;
+		context_parameters.overflow_policy = async_core::context::overflow::block;
+		return this->core_.add_context(
+			this->parent_id_,
+			std::vector<async_core::worker::parameters>(parameters.workers_count),
+			context_parameters
+		);
+	}
+	
+	
+	
+	async_core &core_;
+	const async_core::context_id_type parent_id_, last_context_id_;
+	head_ptr_holder_type head_ptr_holder_ptr_;
+	connector_type connect_tail_;
+	std::vector<std::shared_ptr<pipeline_impl::statistics_source>> stage_ptrs_;
+};	// class pipeline_builder
+
+
+
+// Stages' contexts are added as children of the parent context, so workers of the parent (if any) help all stages.
+template<class In>
+inline
+pipeline_builder<In, In>
+make_pipeline(
+	async_core &core,
+	async_core::context_id_type parent_id
+)
+{
+	const auto head_ptr_holder_ptr = std::make_shared<std::shared_ptr<pipeline_impl::input<In>>>();
+	return pipeline_builder<In, In>{
+		core,
+		parent_id,
+		parent_id,
+		head_ptr_holder_ptr,
+		[head_ptr_holder_ptr](std::shared_ptr<pipeline_impl::input<In>> head_ptr)
+		{
+			*head_ptr_holder_ptr = std::move(head_ptr);
+		},
+		{}
+	};
+}
+
+
+};	// namespace dkuk
+
+
+#endif	// DKUK_PIPELINE_HPP
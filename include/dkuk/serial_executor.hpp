@@ -0,0 +1,360 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 07:12
+
+
+// Serial executor: handlers are executed one at a time in FIFO order, as with io_context::strand. Unlike strand,
+// each executor (constructed from io_context) has its own intrusive lock-free queue (see mpsc_queue), so unrelated
+// executors never serialize each other (io_context::strand uses fixed pool of mutex-protected implementations, so
+// several strands may share one). Copies of the executor share the queue: use them to serialize a group of
+// coroutines/handlers. Queue is processed in batches: one io_context handler executes up to batch_size handlers.
+//
+// Usage:
+// dkuk::serial_executor executor{io_context};
+// executor.post([] { /* ... */ });
+// dkuk::spawn(executor, my_fn);	// Coroutine is serialized with the handlers above
+//
+// NOTE: Executor constructed from io_context::strand posts its batches to the strand, so it is serialized with
+//       other users of the strand too (for compatibility with code, which spawns coroutines in strands).
+// NOTE: Exceptions thrown by handlers are rethrown from io_context's run(), executor continues processing after that.
+// NOTE: Handlers, which are already in the queue, are executed even after destruction of all executor copies.
+//
+// Thread-safety:
+// - serial_executor:
+//     + distinct objects: safe;
+//     + shared object: safe.
+
+
+#ifndef DKUK_SERIAL_EXECUTOR_HPP
+#define DKUK_SERIAL_EXECUTOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/io_context_strand.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/optional.hpp>
+
+#include <dkuk/detail/function_node.hpp>
+#include <dkuk/mpsc_queue.hpp>
+
+
+namespace dkuk {
+
+
+class serial_executor
+{
+public:
+	explicit
+	serial_executor(
+		boost::asio::io_context &io_context,
+		std::size_t batch_size = 64
+	):
+		impl_ptr_{std::make_shared<impl>(io_context, boost::none, batch_size)}
+	{}
+	
+	
+	explicit
+	serial_executor(
+		boost::asio::io_context::strand strand,
+		std::size_t batch_size = 64
+	):
+		impl_ptr_{std::make_shared<impl>(strand.context(), std::move(strand), batch_size)}
+	{}
+	
+	
+	serial_executor(
+		const serial_executor &other
+	) = default;
+	
+	
+	serial_executor &
+	operator=(
+		const serial_executor &other
+	) = default;
+	
+	
+	serial_executor(
+		serial_executor &&other
+	) = default;
+	
+	
+	serial_executor &
+	operator=(
+		serial_executor &&other
+	) = default;
+	
+	
+	inline
+	boost::asio::io_context &
+	context() const noexcept
+	{
+		return this->impl_ptr_->io_context_;
+	}
+	
+	
+	inline
+	void
+	on_work_started() const noexcept
+	{
+		this->impl_ptr_->io_context_.get_executor().on_work_started();
+	}
+	
+	
+	inline
+	void
+	on_work_finished() const noexcept
+	{
+		this->impl_ptr_->io_context_.get_executor().on_work_finished();
+	}
+	
+	
+	// Executes fn inline, if current thread is already inside the executor, otherwise posts it.
+	template<class Fn, class Allocator>
+	inline
+	void
+	dispatch(
+		Fn &&fn,
+		const Allocator & /* allocator */
+	) const
+	{
+		this->dispatch(std::forward<Fn>(fn));
+	}
+	
+	
+	template<class Fn, class Allocator>
+	inline
+	void
+	post(
+		Fn &&fn,
+		const Allocator & /* allocator */
+	) const
+	{
+		this->post(std::forward<Fn>(fn));
+	}
+	
+	
+	template<class Fn, class Allocator>
+	inline
+	void
+	defer(
+		Fn &&fn,
+		const Allocator & /* allocator */
+	) const
+	{
+		this->post(std::forward<Fn>(fn));
+	}
+	
+	
+	// Same as above, but without allocator (as io_context::strand does).
+	template<class Fn>
+	inline
+	void
+	dispatch(
+		Fn &&fn
+	) const
+	{
+		if (this->running_in_this_thread()) {
+			typename std::decay<Fn>::type tmp{std::forward<Fn>(fn)};
+			tmp();
+			return;
+		}
+		this->post(std::forward<Fn>(fn));
+	}
+	
+	
+	template<class Fn>
+	inline
+	void
+	post(
+		Fn &&fn
+	) const
+	{
+		serial_executor::push_(this->impl_ptr_, handler::make(std::forward<Fn>(fn)).release());
+	}
+	
+	
+	// Returns strand, which the executor is constructed from (see above), if any. Use it for code, which needs
+	// io_context::strand of a coroutine (coroutine_context::get_executor() returned it before serial_executor).
+	inline
+	const boost::optional<boost::asio::io_context::strand> &
+	get_strand() const noexcept
+	{
+		return this->impl_ptr_->strand_;
+	}
+	
+	
+	// Returns true, if current thread executes a handler of the executor (or its strand, see above).
+	inline
+	bool
+	running_in_this_thread() const noexcept
+	{
+		const impl &i = *this->impl_ptr_;
+		return serial_executor::current_impl_ptr_() == &i || (i.strand_ && i.strand_->running_in_this_thread());
+	}
+	
+	
+	inline
+	friend
+	bool
+	operator==(
+		const serial_executor &a,
+		const serial_executor &b
+	) noexcept
+	{
+		return a.impl_ptr_ == b.impl_ptr_;
+	}
+	
+	
+	inline
+	friend
+	bool
+	operator!=(
+		const serial_executor &a,
+		const serial_executor &b
+	) noexcept
+	{
+		return a.impl_ptr_ != b.impl_ptr_;
+	}
+private:
+	using handler = detail::function_node<void(), mpsc_queue_hook>;
+	
+	
+	
+	// Executor copies and batch handlers posted to io_context own it together, so the queue stays alive until
+	// the last posted batch is executed (or destroyed with io_context).
+	struct impl
+	{
+		impl(
+			boost::asio::io_context &io_context,
+			boost::optional<boost::asio::io_context::strand> strand,
+			std::size_t batch_size
+		):
+			io_context_{io_context},
+			strand_{std::move(strand)},
+			batch_size_{batch_size}
+		{
+			if (this->batch_size_ == 0)
+				throw std::invalid_argument{"Zero serial executor batch size"};
+		}
+		
+		
+		~impl()
+		{
+			while (handler * const handler_ptr = this->queue_.pop())
+				delete handler_ptr;
+		}
+		
+		
+		
+		boost::asio::io_context &io_context_;
+		boost::optional<boost::asio::io_context::strand> strand_;
+		const std::size_t batch_size_;
+		mpsc_queue<handler> queue_;
+		std::atomic<std::size_t> size_{0};	// Pushed handlers, decreased by processing batch
+	};	// struct impl
+	
+	
+	
+	// Restores executor's state, even if handler throws: exception goes to the io_context's runner.
+	class batch_guard
+	{
+	public:
+		inline
+		batch_guard(
+			const std::shared_ptr<impl> &impl_ptr
+		) noexcept:
+			impl_ptr_{impl_ptr},
+			prev_impl_ptr_{serial_executor::current_impl_ptr_()}
+		{
+			serial_executor::current_impl_ptr_() = impl_ptr.get();
+		}
+		
+		
+		inline
+		~batch_guard()
+		{
+			serial_executor::current_impl_ptr_() = this->prev_impl_ptr_;
+			if (this->impl_ptr_->size_.fetch_sub(this->processed_, std::memory_order_acq_rel) != this->processed_)
+				serial_executor::post_batch_(this->impl_ptr_);	// Let other handlers of the io_context work too
+		}
+		
+		
+		
+		std::size_t processed_ = 0;
+	private:
+		const std::shared_ptr<impl> &impl_ptr_;
+		impl * const prev_impl_ptr_;
+	};	// class batch_guard
+	
+	
+	
+	static inline
+	impl *&
+	current_impl_ptr_() noexcept
+	{
+		static thread_local impl *current_impl_ptr = nullptr;
+		return current_impl_ptr;
+	}
+	
+	
+	static
+	void
+	push_(
+		const std::shared_ptr<impl> &impl_ptr,
+		handler *handler_ptr
+	)
+	{
+		impl_ptr->queue_.push(handler_ptr);
+		if (impl_ptr->size_.fetch_add(1, std::memory_order_acq_rel) == 0)	// Queue was empty: nobody processes it
+			serial_executor::post_batch_(impl_ptr);
+	}
+	
+	
+	static
+	void
+	post_batch_(
+		const std::shared_ptr<impl> &impl_ptr
+	)
+	{
+		if (impl_ptr->strand_)
+			boost::asio::post(*impl_ptr->strand_, [impl_ptr] { serial_executor::process_(impl_ptr); });
+		else
+			boost::asio::post(impl_ptr->io_context_, [impl_ptr] { serial_executor::process_(impl_ptr); });
+	}
+	
+	
+	// Only one processing batch exists at a time (while size_ != 0).
+	static
+	void
+	process_(
+		const std::shared_ptr<impl> &impl_ptr
+	)
+	{
+		impl &i = *impl_ptr;
+		batch_guard guard{impl_ptr};
+		
+		const std::size_t batch_size = std::min(i.size_.load(std::memory_order_acquire), i.batch_size_);
+		while (guard.processed_ < batch_size) {
+			const std::unique_ptr<handler> handler_ptr{i.queue_.pop()};
+			if (handler_ptr == nullptr)	// Producer has counted handler, but older push() is not completed yet
+				break;
+			
+			++guard.processed_;
+			(*handler_ptr)();
+		}
+	}
+	
+	
+	
+	std::shared_ptr<impl> impl_ptr_;
+};	// class serial_executor
+
+
+};	// namespace dkuk
+
+
+#endif	// DKUK_SERIAL_EXECUTOR_HPP
@@ -0,0 +1,591 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 06:18
+
+
+// Thread-per-core (shared-nothing) alternative to async_core. Each shard owns one io_context and one worker
+// thread (pinned to its CPU on Linux), so shard's data can be accessed by its worker only without any locking.
+// Shards communicate with messages: each ordered pair of shards is connected by lock-free single-producer
+// single-consumer ring, so cross-shard messages don't take any locks too.
+//
+// Usage:
+// dkuk::shard_core core{dkuk::shard_core::parameters{}, exception_handler};	// One shard per CPU
+//
+// // Run function on shard and get its result
+// dkuk::coroutine_future<int> result = core.submit_to(1, [] { return 42; });
+//
+// // Inside shard: get shard id and its io_context (for sockets, timers, etc.)
+// dkuk::shard_core::shard_id_type shard = core.get_current_shard().get();
+// boost::asio::io_context &io_context = core.get_io_context(shard);
+//
+// NOTE: Workers poll their io_contexts and rings (see async_core::worker::delay to save CPU).
+// NOTE: Messages from one shard to another are executed in order, while the ring between them has free space.
+//       Otherwise (or if message is submitted by thread, which is not a shard worker) message is queued to the
+//       target shard's inbox, which is run by its io_context.
+// NOTE: stop() breaks promises of messages, which are not executed yet (futures throw std::future_error with
+//       std::future_errc::broken_promise).
+//
+// Thread-safety:
+// - shard_core:
+//     + distinct objects: safe;
+//     + shared object: safe.
+
+
+#ifndef DKUK_SHARD_CORE_HPP
+#define DKUK_SHARD_CORE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#	include <pthread.h>
+#	include <sched.h>
+#endif	// __linux__
+
+#include <boost/asio/detail/concurrency_hint.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/optional.hpp>
+
+#include <dkuk/async_core.hpp>
+#include <dkuk/coroutine.hpp>
+#include <dkuk/detail/function_node.hpp>
+
+
+namespace dkuk {
+
+
+class shard_core
+{
+public:
+	using shard_id_type          = std::size_t;
+	using exception_handler_type = std::function<void (const std::exception &)>;
+	
+	
+	
+	struct parameters
+	{
+		std::size_t                      shards_count  = 0;	// Zero: one shard per CPU
+		bool                             pin_workers   = true;	// Pin worker of shard i to i-th allowed CPU (Linux)
+		std::size_t                      ring_capacity = 1024;	// Messages per shard pair, rounded up to power of 2
+		async_core::worker::parameters   worker_parameters;	// Delay settings only
+	};	// struct parameters
+	
+	
+	
+	shard_core(
+		const parameters &p,
+		exception_handler_type exception_handler,
+		bool start_immediately = true
+	):
+		parameters_{shard_core::fixed_parameters_(p)},
+		exception_handler_{std::move(exception_handler)}
+	{
+		this->create_shards_();
+		if (start_immediately)
+			this->start();
+	}
+	
+	
+	explicit
+	shard_core(
+		const parameters &p,
+		bool start_immediately = true
+	):
+		parameters_{shard_core::fixed_parameters_(p)}
+	{
+		this->create_shards_();
+		if (start_immediately)
+			this->start();
+	}
+	
+	
+	inline
+	~shard_core()
+	{
+		this->stop();
+	}
+	
+	
+	void
+	start()
+	{
+		std::lock_guard<std::mutex> state_lock{this->state_mutex_};
+		if (!this->workers_.empty())
+			return;
+		
+		this->stopping_.store(false, std::memory_order_release);
+		try {
+			if (this->parameters_.pin_workers)
+				this->cpus_ = shard_core::allowed_cpus_();
+			
+			for (auto &shard_ptr: this->shard_ptrs_)
+				this->workers_.emplace_back(&shard_core::worker_run_, this, std::ref(*shard_ptr));
+		} catch (...) {
+			this->stop_workers_();
+			throw;
+		}
+	}
+	
+	
+	void
+	stop()
+	{
+		std::lock_guard<std::mutex> state_lock{this->state_mutex_};
+		this->stop_workers_();
+	}
+	
+	
+	inline
+	std::size_t
+	get_shards_count() const noexcept
+	{
+		return this->shard_ptrs_.size();
+	}
+	
+	
+	inline
+	boost::asio::io_context &
+	get_io_context(
+		shard_id_type shard_id
+	)
+	{
+		return this->shard_ptrs_.at(shard_id)->io_context_;
+	}
+	
+	
+	// Returns id of the shard, which worker is the current thread (or nothing for other threads).
+	inline
+	boost::optional<shard_id_type>
+	get_current_shard() const noexcept
+	{
+		const current_shard_info &info = shard_core::current_shard_();
+		if (info.core_ptr == this)
+			return info.shard_id;
+		return boost::none;
+	}
+	
+	
+	// Executes fn() on the shard. Result (or exception) is available through the future.
+	template<class Fn>
+	auto
+	submit_to(
+		shard_id_type shard_id,
+		Fn &&fn
+	)
+	{
+		using result_type = decltype(fn());
+		
+		shard &target = *this->shard_ptrs_.at(shard_id);
+		const boost::optional<shard_id_type> current_shard_id = this->get_current_shard();
+		
+		// Future's handlers are posted to the caller's shard, if any
+		coroutine_promise<result_type> result_promise{
+			(current_shard_id)? this->shard_ptrs_[current_shard_id.get()]->io_context_: target.io_context_
+		};
+		coroutine_future<result_type> result_future = result_promise.get_future();
+		
+		task_ptr_type task_ptr = task::make(
+			[fn = std::forward<Fn>(fn), result_promise = std::move(result_promise)](bool run) mutable
+			{
+				if (!run) {	// Core is stopped
+					result_promise.set_exception(
+						std::make_exception_ptr(std::future_error{std::future_errc::broken_promise})
+					);
+					return;
+				}
+				
+				try {
+					shard_core::set_result_(result_promise, fn);
+				} catch (const std::exception & /* e */) {
+					result_promise.set_exception(std::current_exception());
+				}
+			}
+		);
+		
+		if (current_shard_id && current_shard_id.get() != shard_id) {
+			ring &r = this->get_ring_(current_shard_id.get(), shard_id);
+			if (r.try_push(task_ptr))
+				return result_future;
+		}
+		
+		{
+			std::lock_guard<std::mutex> inbox_lock{target.inbox_mutex_};
+			target.inbox_.push_back(std::move(task_ptr));
+		}
+		boost::asio::post(target.io_context_, [&target] { shard_core::run_inbox_task_(target); });
+		return result_future;
+	}
+private:
+	using task = detail::function_node<void(bool run)>;	// Message between shards, cancelled, if !run
+	using task_ptr_type = std::unique_ptr<task>;
+	
+	
+	
+	// Lock-free single-producer single-consumer ring. Head and tail are padded to different cache lines, each
+	// side caches the other's index to touch the shared cache line only when the ring looks full (or empty).
+	class ring
+	{
+	public:
+		explicit
+		ring(
+			std::size_t capacity
+		):
+			slots_(capacity),
+			mask_{capacity - 1}
+		{}
+		
+		
+		// Producer side.
+		inline
+		bool
+		try_push(
+			task_ptr_type &task_ptr
+		)
+		{
+			const std::size_t tail = this->tail_.load(std::memory_order_relaxed);
+			if (tail - this->head_cache_ > this->mask_) {
+				this->head_cache_ = this->head_.load(std::memory_order_acquire);
+				if (tail - this->head_cache_ > this->mask_)
+					return false;
+			}
+			
+			this->slots_[tail & this->mask_] = std::move(task_ptr);
+			this->tail_.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+		
+		
+		// Consumer side. Executes (or cancels, if !run) messages available at the moment, returns number of them.
+		inline
+		std::size_t
+		consume(
+			bool run = true
+		)
+		{
+			std::size_t head = this->head_.load(std::memory_order_relaxed);
+			if (head == this->tail_cache_) {
+				this->tail_cache_ = this->tail_.load(std::memory_order_acquire);
+				if (head == this->tail_cache_)
+					return 0;
+			}
+			
+			const std::size_t tail = this->tail_cache_;
+			const std::size_t consumed = tail - head;
+			while (head != tail) {
+				const task_ptr_type task_ptr = std::move(this->slots_[head & this->mask_]);
+				this->head_.store(++head, std::memory_order_release);	// Before execution: task may throw
+				(*task_ptr)(run);
+			}
+			return consumed;
+		}
+	private:
+		static constexpr std::size_t cache_line_size = 64;
+		
+		
+		
+		std::vector<task_ptr_type> slots_;
+		const std::size_t mask_;
+		
+		char padding0_[cache_line_size];
+		std::atomic<std::size_t> head_{0};
+		std::size_t tail_cache_ = 0;	// Consumer's copy of tail
+		
+		char padding1_[cache_line_size];
+		std::atomic<std::size_t> tail_{0};
+		std::size_t head_cache_ = 0;	// Producer's copy of head
+		
+		char padding2_[cache_line_size];
+	};	// class ring
+	
+	
+	
+	struct shard
+	{
+		inline
+		explicit
+		shard(
+			shard_id_type id
+		):
+			io_context_{BOOST_ASIO_CONCURRENCY_HINT_1},	// Foreign threads may post to it
+			work_guard_{boost::asio::make_work_guard(this->io_context_)},
+			id_{id}
+		{}
+		
+		
+		
+		boost::asio::io_context io_context_;
+		boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work_guard_;
+		const shard_id_type id_;
+		
+		// Messages, which don't fit the rings or are submitted by foreign threads. Each of them has its own task
+		// in io_context, which runs the oldest message (if it isn't cancelled by stop yet).
+		std::mutex inbox_mutex_;
+		std::deque<task_ptr_type> inbox_;
+	};	// struct shard
+	
+	
+	
+	struct current_shard_info
+	{
+		const shard_core *core_ptr = nullptr;
+		shard_id_type shard_id = 0;
+	};	// struct current_shard_info
+	
+	
+	
+	static
+	parameters
+	fixed_parameters_(
+		parameters p
+	)
+	{
+		if (p.shards_count == 0)
+			p.shards_count = shard_core::allowed_cpus_().size();
+		
+		std::size_t ring_capacity = 1;
+		while (ring_capacity < p.ring_capacity)
+			ring_capacity <<= 1;
+		p.ring_capacity = ring_capacity;
+		
+		if (p.worker_parameters.delay_rounds < 1)
+			p.worker_parameters.delay_rounds = 1;
+		
+		return p;
+	}
+	
+	
+	static inline
+	current_shard_info &
+	current_shard_() noexcept
+	{
+		static thread_local current_shard_info info;
+		return info;
+	}
+	
+	
+	template<class T, class Fn>
+	static inline
+	void
+	set_result_(
+		coroutine_promise<T> &result_promise,
+		Fn &fn
+	)
+	{
+		result_promise.set_value(fn());
+	}
+	
+	
+	template<class Fn>
+	static inline
+	void
+	set_result_(
+		coroutine_promise<void> &result_promise,
+		Fn &fn
+	)
+	{
+		fn();
+		result_promise.set_value();
+	}
+	
+	
+	void
+	create_shards_()
+	{
+		const std::size_t shards_count = this->parameters_.shards_count;
+		
+		this->shard_ptrs_.reserve(shards_count);
+		for (shard_id_type i = 0; i < shards_count; ++i)
+			this->shard_ptrs_.emplace_back(new shard{i});
+		
+		this->ring_ptrs_.reserve(shards_count * shards_count);
+		for (std::size_t i = 0; i < shards_count * shards_count; ++i)
+			this->ring_ptrs_.emplace_back(
+				(i / shards_count != i % shards_count)? new ring{this->parameters_.ring_capacity}: nullptr
+			);
+	}
+	
+	
+	// Ring from shard "from" to shard "to".
+	inline
+	ring &
+	get_ring_(
+		shard_id_type from,
+		shard_id_type to
+	) noexcept
+	{
+		return *this->ring_ptrs_[from * this->shard_ptrs_.size() + to];
+	}
+	
+	
+	static
+	void
+	run_inbox_task_(
+		shard &s
+	)
+	{
+		task_ptr_type task_ptr;
+		{
+			std::lock_guard<std::mutex> inbox_lock{s.inbox_mutex_};
+			if (s.inbox_.empty())	// Cancelled by stop
+				return;
+			task_ptr = std::move(s.inbox_.front());
+			s.inbox_.pop_front();
+		}
+		(*task_ptr)(true);
+	}
+	
+	
+	// Requires state lock. Rings are consumed by workers only, so they are cancelled after join.
+	void
+	stop_workers_()
+	{
+		this->stopping_.store(true, std::memory_order_release);
+		for (auto &worker: this->workers_)
+			worker.join();
+		this->workers_.clear();
+		
+		for (auto &ring_ptr: this->ring_ptrs_)
+			if (ring_ptr != nullptr)
+				ring_ptr->consume(false);
+		
+		for (auto &shard_ptr: this->shard_ptrs_) {
+			std::deque<task_ptr_type> inbox;
+			{
+				std::lock_guard<std::mutex> inbox_lock{shard_ptr->inbox_mutex_};
+				inbox.swap(shard_ptr->inbox_);
+			}
+			for (const auto &task_ptr: inbox)
+				(*task_ptr)(false);
+		}
+	}
+	
+	
+	void
+	worker_run_(
+		shard &s
+	)
+	{
+		current_shard_info &info = shard_core::current_shard_();
+		info.core_ptr = this;
+		info.shard_id = s.id_;
+		
+		if (this->parameters_.pin_workers)
+			shard_core::pin_current_thread_(this->cpus_[s.id_ % this->cpus_.size()]);
+		
+		const async_core::worker::parameters &worker_parameters = this->parameters_.worker_parameters;
+		const std::size_t shards_count = this->shard_ptrs_.size();
+		
+		std::size_t wait_rounds = 0;
+		while (!this->stopping_.load(std::memory_order_relaxed)) {
+			try {
+				while (!this->stopping_.load(std::memory_order_relaxed)) {
+					if (wait_rounds >= worker_parameters.delay_rounds) {
+						wait_rounds = 0;
+						shard_core::delay_(worker_parameters);
+					}
+					
+					std::size_t executed = s.io_context_.poll();
+					for (shard_id_type from = 0; from < shards_count; ++from)
+						if (from != s.id_)
+							executed += this->get_ring_(from, s.id_).consume();
+					
+					if (executed == 0)
+						++wait_rounds;
+				}
+			} catch (const std::exception &e) {
+				if (this->exception_handler_)
+					this->exception_handler_(e);
+			}
+		}
+		
+		info = current_shard_info{};
+	}
+	
+	
+	// Returns CPUs, which the current thread may run on (taskset, cgroups cpusets), or one CPU per hardware thread
+	// on other systems.
+	static inline
+	std::vector<int>
+	allowed_cpus_()
+	{
+		std::vector<int> cpus;
+#ifdef __linux__
+		cpu_set_t cpu_set;
+		CPU_ZERO(&cpu_set);
+		if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0)
+			for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+				if (CPU_ISSET(cpu, &cpu_set))
+					cpus.push_back(cpu);
+#endif	// __linux__
+		if (cpus.empty())
+			for (unsigned int cpu = 0; cpu < std::max(std::thread::hardware_concurrency(), 1u); ++cpu)
+				cpus.push_back(static_cast<int>(cpu));
+		return cpus;
+	}
+	
+	
+	// Errors are ignored: worker just runs without affinity.
+	static inline
+	void
+	pin_current_thread_(
+		int cpu
+	) noexcept
+	{
+#ifdef __linux__
+		cpu_set_t cpu_set;
+		CPU_ZERO(&cpu_set);
+		CPU_SET(cpu, &cpu_set);
+		pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+#else	// __linux__
+		static_cast<void>(cpu);
+#endif	// __linux__
+	}
+	
+	
+	static inline
+	void
+	delay_(
+		const async_core::worker::parameters &worker_parameters
+	)
+	{
+		switch (worker_parameters.delay_policy) {
+			case async_core::worker::delay::no_delay:
+				break;
+			case async_core::worker::delay::yield:
+				std::this_thread::yield();
+				break;
+			case async_core::worker::delay::sleep:
+				std::this_thread::sleep_for(worker_parameters.delay_value);
+				break;
+		}
+	}
+	
+	
+	
+	const parameters parameters_;
+	exception_handler_type exception_handler_;
+	
+	std::vector<std::unique_ptr<shard>> shard_ptrs_;
+	std::vector<std::unique_ptr<ring>> ring_ptrs_;	// shards_count x shards_count, diagonal is empty
+	
+	std::mutex state_mutex_;
+	std::atomic<bool> stopping_{false};
+	std::vector<int> cpus_;	// Allowed for the thread, which started workers: shard i is pinned to cpus_[i % size]
+	std::vector<std::thread> workers_;
+};	// class shard_core
+
+
+};	// namespace dkuk
+
+
+#endif	// DKUK_SHARD_CORE_HPP
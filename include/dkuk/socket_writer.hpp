@@ -0,0 +1,265 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 07:22
+
+
+// Socket writer, which coalesces writes of several coroutines (or other async operations) to one socket. Messages
+// are queued, and queue is flushed by one gathering write (writev) per event loop turn (corking): the first message
+// schedules the flush, messages queued before it runs (or while the previous flush is in progress) are sent together.
+// Each writer is completed, when its bytes are sent.
+//
+// Usage:
+// dkuk::socket_writer<boost::asio::ip::tcp::socket> writer{socket};
+//
+// void publish(dkuk::socket_writer<boost::asio::ip::tcp::socket> &writer, message m, dkuk::coroutine_context context)
+// {
+//     std::size_t bytes_transferred = writer.async_write(boost::asio::buffer(m.data()), context);
+// }
+//
+// NOTE: As with boost::asio::async_write(), data should be valid until completion of the write.
+// NOTE: Writer should outlive its operations (as the socket should). Don't write to the socket directly, while the
+//       writer is used.
+// NOTE: Messages are sent in the order of async_write() calls. Messages are not interleaved.
+// NOTE: If write fails, all messages of the flush are completed with the error (and bytes sent for each of them).
+// NOTE: Handler is invoked by its associated executor (socket's executor by default), which has outstanding work
+//       while the message is queued.
+//
+// Thread-safety:
+// - socket_writer:
+//     + distinct objects: safe;
+//     + shared object: safe.
+
+
+#ifndef DKUK_SOCKET_WRITER_HPP
+#define DKUK_SOCKET_WRITER_HPP
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/dispatch.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <dkuk/detail/function_node.hpp>
+
+
+namespace dkuk {
+
+
+template<class Socket>
+class socket_writer
+{
+public:
+	using socket_type = Socket;
+	
+	
+	
+	struct statistics
+	{
+		std::size_t messages_count = 0;
+		std::size_t flushes_count  = 0;	// Gathering writes (each of them takes one or several syscalls)
+	};	// struct statistics
+	
+	
+	
+	explicit
+	socket_writer(
+		Socket &socket
+	) noexcept:
+		socket_{socket}
+	{}
+	
+	
+	socket_writer(
+		const socket_writer &other
+	) = delete;
+	
+	
+	socket_writer &
+	operator=(
+		const socket_writer &other
+	) = delete;
+	
+	
+	// Handler signature: void (boost::system::error_code, std::size_t bytes_transferred).
+	// Handler may be coroutine_context: then bytes_transferred is returned.
+	template<class ConstBufferSequence, class Handler>
+	inline
+	auto
+	async_write(
+		const ConstBufferSequence &buffers,
+		Handler &&handler
+	)
+	{
+		boost::asio::async_completion<Handler, void (boost::system::error_code, std::size_t)> init{handler};
+		
+		request_ptr_type request_ptr = this->make_request_(std::move(init.completion_handler));
+		const auto end = boost::asio::buffer_sequence_end(buffers);
+		for (auto it = boost::asio::buffer_sequence_begin(buffers); it != end; ++it) {
+			const boost::asio::const_buffer buffer{*it};
+			request_ptr->buffers_.push_back(buffer);
+			request_ptr->size_ += buffer.size();
+		}
+		
+		this->push_(std::move(request_ptr));
+		return init.result.get();
+	}
+	
+	
+	inline
+	Socket &
+	get_socket() const noexcept
+	{
+		return this->socket_;
+	}
+	
+	
+	inline
+	statistics
+	get_statistics() const
+	{
+		std::lock_guard<std::mutex> lock{this->mutex_};
+		return this->statistics_;
+	}
+private:
+	struct request_buffers
+	{
+		std::vector<boost::asio::const_buffer> buffers_;
+		std::size_t size_ = 0;
+	};	// struct request_buffers
+	
+	
+	
+	// Queued message: its buffers and handler
+	using request = detail::function_node<void(const boost::system::error_code &, std::size_t), request_buffers>;
+	using request_ptr_type = std::unique_ptr<request>;
+	
+	
+	
+	template<class Handler>
+	inline
+	request_ptr_type
+	make_request_(
+		Handler &&handler
+	)
+	{
+		const auto executor = boost::asio::get_associated_executor(handler, this->socket_.get_executor());
+		return request::make(
+			[work_guard = boost::asio::make_work_guard(executor), handler = std::forward<Handler>(handler)](
+				const boost::system::error_code &ec,
+				std::size_t bytes_transferred
+			) mutable
+			{
+				boost::asio::dispatch(
+					work_guard.get_executor(),
+					[handler = std::move(handler), ec, bytes_transferred]() mutable
+					{
+						handler(ec, bytes_transferred);
+					}
+				);
+				work_guard.reset();
+			}
+		);
+	}
+	
+	
+	inline
+	void
+	push_(
+		request_ptr_type request_ptr
+	)
+	{
+		{
+			std::lock_guard<std::mutex> lock{this->mutex_};
+			this->pending_request_ptrs_.push_back(std::move(request_ptr));
+			++this->statistics_.messages_count;
+			if (this->flushing_)	// Flush is scheduled or in progress: it takes the message
+				return;
+			this->flushing_ = true;
+		}
+		
+		boost::asio::post(this->socket_.get_executor(), [this] { this->flush_(); });
+	}
+	
+	
+	// Only one flush exists at a time (while flushing_ is set): in-flight requests and buffers are not locked.
+	void
+	flush_()
+	{
+		{
+			std::lock_guard<std::mutex> lock{this->mutex_};
+			if (this->pending_request_ptrs_.empty()) {
+				this->flushing_ = false;
+				return;
+			}
+			this->in_flight_request_ptrs_.swap(this->pending_request_ptrs_);
+			++this->statistics_.flushes_count;
+		}
+		
+		this->in_flight_buffers_.clear();
+		for (const auto &request_ptr: this->in_flight_request_ptrs_)
+			this->in_flight_buffers_.insert(
+				this->in_flight_buffers_.end(),
+				request_ptr->buffers_.begin(),
+				request_ptr->buffers_.end()
+			);
+		
+		boost::asio::async_write(
+			this->socket_,
+			this->in_flight_buffers_,
+			[this](const boost::system::error_code &ec, std::size_t bytes_transferred)
+			{
+				this->complete_(ec, bytes_transferred);
+			}
+		);
+	}
+	
+	
+	void
+	complete_(
+		const boost::system::error_code &ec,
+		std::size_t bytes_transferred
+	)
+	{
+		std::vector<request_ptr_type> request_ptrs;
+		request_ptrs.swap(this->in_flight_request_ptrs_);
+		
+		// Messages queued during the write are sent by the next flush immediately
+		this->flush_();
+		
+		for (const auto &request_ptr: request_ptrs) {
+			const std::size_t request_bytes_transferred = std::min(request_ptr->size_, bytes_transferred);
+			bytes_transferred -= request_bytes_transferred;
+			(*request_ptr)(ec, request_bytes_transferred);
+		}
+		
+		request_ptrs.clear();
+		std::lock_guard<std::mutex> lock{this->mutex_};
+		if (this->pending_request_ptrs_.capacity() == 0)	// Give the vector back for reuse
+			this->pending_request_ptrs_.swap(request_ptrs);
+	}
+	
+	
+	
+	Socket &socket_;
+	
+	mutable std::mutex mutex_;
+	std::vector<request_ptr_type> pending_request_ptrs_;
+	bool flushing_ = false;
+	statistics statistics_;
+	
+	std::vector<request_ptr_type> in_flight_request_ptrs_;
+	std::vector<boost::asio::const_buffer> in_flight_buffers_;
+};	// class socket_writer
+
+
+};	// namespace dkuk
+
+
+#endif	// DKUK_SOCKET_WRITER_HPP
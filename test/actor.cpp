@@ -0,0 +1,230 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 07:01
+
+#include <chrono>
+#include <initializer_list>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+
+#include <dkuk/actor.hpp>
+#include <dkuk/async_core.hpp>
+#include <dkuk/coroutine.hpp>
+#include <dkuk/mpsc_queue.hpp>
+
+
+namespace {
+
+
+constexpr std::size_t producers_count = 4, messages_count = 10000;
+
+
+struct node: dkuk::mpsc_queue_hook
+{
+	std::size_t producer, value;
+};	// struct node
+
+
+// Each producer's nodes are popped in order.
+void
+check_mpsc_queue()
+{
+	dkuk::mpsc_queue<node> q;
+	std::vector<node> nodes(producers_count * messages_count);
+	
+	std::vector<std::thread> producers;
+	for (std::size_t i = 0; i < producers_count; ++i)
+		producers.emplace_back(
+			[&q, &nodes, i]
+			{
+				for (std::size_t j = 0; j < messages_count; ++j) {
+					node &n = nodes[i * messages_count + j];
+					n.producer = i;
+					n.value = j;
+					q.push(&n);
+				}
+			}
+		);
+	
+	std::vector<std::size_t> next_values(producers_count, 0);
+	std::size_t popped = 0;
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+	while (popped < nodes.size() && std::chrono::steady_clock::now() < deadline) {
+		const node * const n = q.pop();
+		if (n == nullptr)
+			continue;
+		if (n->value != next_values[n->producer]++)
+			throw std::logic_error{"MPSC queue: incorrect order"};
+		++popped;
+	}
+	
+	for (auto &producer: producers)
+		producer.join();
+	
+	if (popped != nodes.size() || q.pop() != nullptr)
+		throw std::logic_error{"MPSC queue: popped " + std::to_string(popped) + " nodes"};
+}
+
+
+// Counter is modified by several threads without locks, result is read with ask().
+void
+check_actor()
+{
+	dkuk::async_core::context_tree t;
+	const auto root = t.add_context(0, 4);
+	dkuk::async_core core{t, true};
+	
+	dkuk::actor<std::size_t> counter{core, root, 0};
+	
+	std::vector<std::thread> producers;
+	for (std::size_t i = 0; i < producers_count; ++i)
+		producers.emplace_back(
+			[&counter]
+			{
+				for (std::size_t j = 0; j < messages_count; ++j)
+					counter.tell([](std::size_t &value) { ++value; });
+			}
+		);
+	for (auto &producer: producers)
+		producer.join();
+	
+	// Messages are executed in order, so ask() sees all tells
+	const std::size_t value = counter.ask([](const std::size_t &value) { return value; }).get();
+	
+	// ask() from coroutine
+	auto result_future =
+		dkuk::spawn_with_future(
+			core.get_io_context(root),
+			[&counter](dkuk::coroutine_context context)
+			{
+				return counter.ask([](std::size_t &value) { return value * 2; }).get(context);
+			}
+		);
+	const std::size_t doubled_value = result_future.get();
+	
+	bool exception_returned = false;
+	try {
+		counter.ask([](std::size_t &) -> int { throw std::runtime_error{"Expected"}; }).get();
+	} catch (const std::runtime_error &) {
+		exception_returned = true;
+	}
+	
+	core.stop();
+	
+	if (value != producers_count * messages_count || doubled_value != 2 * value)
+		throw std::logic_error{"Actor: incorrect value: " + std::to_string(value)};
+	if (!exception_returned)
+		throw std::logic_error{"Actor: exception is not returned through future"};
+}
+
+
+// Bounded mailbox of not running actor overflows.
+void
+check_bounded_mailbox()
+{
+	constexpr std::size_t capacity = 10;
+	
+	boost::asio::io_context io_context;
+	dkuk::actor<std::size_t>::parameters parameters;
+	parameters.capacity   = capacity;
+	parameters.batch_size = 3;
+	dkuk::actor<std::size_t> counter{io_context, 0, parameters};
+	
+	std::size_t accepted = 0;
+	for (std::size_t i = 0; i < 2 * capacity; ++i)
+		if (counter.try_tell([](std::size_t &value) { ++value; }))
+			++accepted;
+	
+	bool thrown = false;
+	try {
+		counter.tell([](std::size_t &value) { ++value; });
+	} catch (const dkuk::mailbox_overflow &) {
+		thrown = true;
+	}
+	
+	if (accepted != capacity || !thrown)
+		throw std::logic_error{"Bounded mailbox: accepted " + std::to_string(accepted) + " messages"};
+	
+	io_context.run();
+	
+	// Mailbox is free again
+	auto result_future = counter.ask([](std::size_t &value) { return value; });
+	io_context.restart();
+	io_context.run();
+	if (result_future.get() != capacity)
+		throw std::logic_error{"Bounded mailbox: incorrect value"};
+}
+
+
+// async_tell() waits for place in bounded mailbox: messages of the coroutine and the callback are not lost and keep
+// their order.
+void
+check_async_tell()
+{
+	static constexpr std::size_t capacity = 2, coroutine_messages_count = 100;
+	
+	boost::asio::io_context io_context;
+	dkuk::actor<std::vector<std::size_t>>::parameters parameters;
+	parameters.capacity   = capacity;
+	parameters.batch_size = 1;
+	dkuk::actor<std::vector<std::size_t>> log{io_context, {}, parameters};
+	
+	// Mailbox is full before io_context runs: callback waits
+	for (std::size_t i = 0; i < capacity; ++i)
+		log.tell([i](std::vector<std::size_t> &values) { values.push_back(i); });
+	bool callback_called = false;
+	log.async_tell(
+		[](std::vector<std::size_t> &values) { values.push_back(capacity); },
+		[&callback_called] { callback_called = true; }
+	);
+	if (callback_called)
+		throw std::logic_error{"async_tell: handler is called before place is freed"};
+	
+	dkuk::spawn(
+		io_context,
+		[&](dkuk::coroutine_context context)
+		{
+			for (std::size_t i = 0; i < coroutine_messages_count; ++i)
+				log.async_tell([i](std::vector<std::size_t> &values) { values.push_back(capacity + 1 + i); }, context);
+		}
+	);
+	io_context.run();
+	
+	auto result_future = log.ask([](std::vector<std::size_t> &values) { return values; });
+	io_context.restart();
+	io_context.run();
+	const std::vector<std::size_t> values = result_future.get();
+	
+	if (!callback_called)
+		throw std::logic_error{"async_tell: handler is not called"};
+	if (values.size() != capacity + 1 + coroutine_messages_count)
+		throw std::logic_error{"async_tell: messages executed: " + std::to_string(values.size())};
+	for (std::size_t i = 0; i < values.size(); ++i)
+		if (values[i] != i)
+			throw std::logic_error{"async_tell: incorrect order"};
+}
+
+
+};	// namespace
+
+
+
+int
+main()
+{
+	int status = 0;
+	
+	for (const auto &check: {check_mpsc_queue, check_actor, check_bounded_mailbox, check_async_tell}) {
+		try {
+			check();
+		} catch (const std::exception &e) {
+			std::cout << "Error: " << e.what() << '.' << std::endl;
+			status = 1;
+		}
+	}
+	
+	return status;
+}
@@ -0,0 +1,159 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 06:02
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <boost/asio/post.hpp>
+
+#include <dkuk/async_core.hpp>
+
+
+namespace {
+
+
+void
+wait_executed(
+	const std::atomic<std::size_t> &executed,
+	std::size_t expected,
+	const std::string &what
+)
+{
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+	while (executed < expected && std::chrono::steady_clock::now() < deadline)
+		std::this_thread::sleep_for(std::chrono::milliseconds{1});
+	
+	if (executed != expected)
+		throw std::logic_error{
+			what + ": executed " + std::to_string(executed.load()) + " of " + std::to_string(expected)
+		};
+}
+
+
+void
+post_tasks(
+	dkuk::async_core &core,
+	dkuk::async_core::context_id_type context_id,
+	std::size_t count,
+	std::atomic<std::size_t> &executed
+)
+{
+	for (std::size_t i = 0; i < count; ++i)
+		boost::asio::post(core.get_io_context(context_id), [&executed] { ++executed; });
+}
+
+
+template<class Fn>
+void
+expect_exception(
+	Fn &&fn,
+	const std::string &what
+)
+{
+	try {
+		fn();
+	} catch (const std::exception &) {
+		return;
+	}
+	throw std::logic_error{"Expected exception: " + what};
+}
+
+
+};	// namespace
+
+
+
+int
+main()
+{
+	dkuk::async_core::worker::parameters children_only;
+	children_only.self_poll_policy = dkuk::async_core::worker::poll::disabled;
+	
+	
+	try {
+		std::atomic<std::size_t> executed{0};
+		
+		
+		// Root worker runs root context only (single mode), so it must be woken up by new child
+		dkuk::async_core::context_tree t;
+		const auto root = t.add_context(0, 1);
+		dkuk::async_core core{t};
+		
+		const auto tenant1 = core.add_context(root);
+		post_tasks(core, tenant1, 100, executed);
+		wait_executed(executed, 100, "Tenant 1 (common worker)");
+		
+		
+		// Tenant with dedicated worker and nested context
+		const auto tenant2 = core.add_context(root, 1);
+		const auto tenant2_child = core.add_context(tenant2);
+		post_tasks(core, tenant2, 100, executed);
+		post_tasks(core, tenant2_child, 100, executed);
+		wait_executed(executed, 300, "Tenant 2 (dedicated worker)");
+		
+		
+		// Retirement
+		expect_exception([&] { core.retire_context(root); }, "retire root");
+		expect_exception([&] { core.retire_context(tenant2); }, "retire context with active children");
+		
+		core.retire_context(tenant2_child);
+		core.retire_context(tenant2);
+		core.retire_context(tenant1);
+		if (!core.get_io_context(tenant1).stopped() || !core.get_io_context(tenant2).stopped())
+			throw std::logic_error{"Retired context is not stopped"};
+		
+		expect_exception([&] { core.add_context(tenant1); }, "add context to retired parent");
+		
+		
+		// Root worker still works after retirements, new tenants get new ids
+		const auto tenant3 = core.add_context(root);
+		if (tenant3 <= tenant2_child)
+			throw std::logic_error{"Context id reused"};
+		post_tasks(core, root, 100, executed);
+		post_tasks(core, tenant3, 100, executed);
+		wait_executed(executed, 500, "Tenant 3");
+		
+		
+		// Worker without contexts to run waits for them
+		dkuk::async_core::context_tree u;
+		const auto u_root = u.add_context(0, 0);
+		u.add_worker(u_root, children_only);
+		dkuk::async_core core_u{u};
+		
+		std::this_thread::sleep_for(std::chrono::milliseconds{10});
+		const auto u_child = core_u.add_context(u_root);
+		post_tasks(core_u, u_child, 100, executed);
+		wait_executed(executed, 600, "Waiting worker");
+		
+		
+		// Contexts added to stopped core are started by start()
+		core_u.stop();
+		const auto u_child2 = core_u.add_context(u_root, 1);
+		post_tasks(core_u, u_child2, 100, executed);
+		core_u.start();
+		wait_executed(executed, 700, "Added to stopped core");
+		
+		
+		// Root worker runs the only child (single mode) together with its own worker. Wake up is targeted,
+		// so it can't be eaten by the child's own worker, and root worker picks up the new child.
+		dkuk::async_core::context_tree v;
+		const auto v_root = v.add_context(0, 0);
+		const auto v_child = v.add_context(v_root, 1);
+		v.add_worker(v_root, children_only);
+		dkuk::async_core core_v{v};
+		
+		std::this_thread::sleep_for(std::chrono::milliseconds{10});
+		const auto v_child2 = core_v.add_context(v_root);
+		post_tasks(core_v, v_child, 100, executed);
+		post_tasks(core_v, v_child2, 100, executed);
+		wait_executed(executed, 900, "Single worker of parent");
+	} catch (const std::exception &e) {
+		std::cout << "Error: " << e.what() << '.' << std::endl;
+		return 1;
+	}
+	
+	return 0;
+}
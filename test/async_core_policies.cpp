@@ -0,0 +1,189 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 05:56
+
+#include <atomic>
+#include <chrono>
+#include <initializer_list>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <boost/asio/post.hpp>
+
+#include <dkuk/async_core.hpp>
+
+
+namespace {
+
+
+const char *
+to_string(dkuk::async_core::worker::poll poll_policy) noexcept
+{
+	switch (poll_policy) {
+		case dkuk::async_core::worker::poll::disabled: return "disabled";
+		case dkuk::async_core::worker::poll::poll_one: return "poll_one";
+		case dkuk::async_core::worker::poll::poll_all: return "poll_all";
+		case dkuk::async_core::worker::poll::run_one:  return "run_one";
+	}
+	return "unknown";
+}
+
+
+const char *
+to_string(dkuk::async_core::worker::delay delay_policy) noexcept
+{
+	switch (delay_policy) {
+		case dkuk::async_core::worker::delay::no_delay: return "no_delay";
+		case dkuk::async_core::worker::delay::yield:    return "yield";
+		case dkuk::async_core::worker::delay::sleep:    return "sleep";
+	}
+	return "unknown";
+}
+
+
+// Root worker runs root (self) and two child contexts; one task per context throws.
+void
+check_policies(
+	dkuk::async_core::worker::poll self_poll_policy,
+	dkuk::async_core::worker::poll children_poll_policy,
+	dkuk::async_core::worker::delay delay_policy
+)
+{
+	constexpr std::size_t tasks_per_context = 100;
+	
+	dkuk::async_core::worker::parameters parameters;
+	parameters.self_poll_policy     = self_poll_policy;
+	parameters.children_poll_policy = children_poll_policy;
+	parameters.delay_policy         = delay_policy;
+	parameters.delay_value          = std::chrono::milliseconds{1};
+	parameters.statistics           = true;
+	
+	dkuk::async_core::context_tree t;
+	const auto root = t.add_context(0, 0);
+	const auto c1   = t.add_context(root, 0);
+	const auto c2   = t.add_context(root, 0);
+	t.add_worker(root, parameters);
+	
+	std::atomic<std::size_t> executed{0}, exceptions{0};
+	dkuk::async_core core{t, [&](const std::exception &) { ++exceptions; }, false};
+	
+	std::size_t expected = 0;
+	for (const auto context_id: {root, c1, c2}) {
+		const bool polled =
+			(context_id == root)
+			? self_poll_policy != dkuk::async_core::worker::poll::disabled
+			: children_poll_policy != dkuk::async_core::worker::poll::disabled;
+		if (!polled)
+			continue;
+		
+		boost::asio::post(core.get_io_context(context_id), [] { throw std::logic_error{"As expected"}; });
+		for (std::size_t i = 0; i < tasks_per_context; ++i)
+			boost::asio::post(core.get_io_context(context_id), [&executed] { ++executed; });
+		expected += tasks_per_context;
+	}
+	
+	core.start();
+	
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+	while (executed < expected && std::chrono::steady_clock::now() < deadline)
+		std::this_thread::sleep_for(std::chrono::milliseconds{1});
+	std::this_thread::sleep_for(std::chrono::milliseconds{10});	// Idle rounds
+	
+	core.stop();
+	
+	if (executed != expected || exceptions != expected / tasks_per_context)
+		throw std::logic_error{
+			std::string{"Policies "} + to_string(self_poll_policy) + '/' + to_string(children_poll_policy)
+			+ '/' + to_string(delay_policy) + ": executed " + std::to_string(executed.load())
+			+ " of " + std::to_string(expected) + ", exceptions: " + std::to_string(exceptions.load())
+		};
+	
+	// Handlers interrupted by exceptions are not counted by poll(). Worker of single context blocks in run_one()
+	// instead of idle rounds.
+	const bool polling = children_poll_policy != dkuk::async_core::worker::poll::disabled;
+	const dkuk::async_core::worker::statistics statistics = core.get_worker_statistics(root);
+	if (
+		statistics.handlers_executed > expected || statistics.idle_rounds >= statistics.rounds
+		|| (polling && (statistics.idle_rounds == 0 || statistics.delays == 0))
+	)
+		throw std::logic_error{
+			std::string{"Policies "} + to_string(self_poll_policy) + '/' + to_string(children_poll_policy)
+			+ '/' + to_string(delay_policy) + ": incorrect worker statistics, rounds: "
+			+ std::to_string(statistics.rounds) + ", idle: " + std::to_string(statistics.idle_rounds)
+			+ ", handlers: " + std::to_string(statistics.handlers_executed)
+		};
+}
+
+
+// Workers don't collect statistics by default.
+void
+check_statistics_disabled()
+{
+	dkuk::async_core::worker::parameters parameters;
+	parameters.delay_policy = dkuk::async_core::worker::delay::no_delay;
+	
+	dkuk::async_core::context_tree t;
+	const auto root = t.add_context(0, 0);
+	t.add_context(root, 0);
+	t.add_context(root, 0);
+	t.add_worker(root, parameters);
+	
+	std::atomic<std::size_t> executed{0};
+	dkuk::async_core core{t, false};
+	boost::asio::post(core.get_io_context(root), [&executed] { ++executed; });
+	
+	core.start();
+	std::this_thread::sleep_for(std::chrono::milliseconds{10});
+	core.stop();
+	
+	const dkuk::async_core::worker::statistics statistics = core.get_worker_statistics(root);
+	if (executed != 1 || statistics.rounds != 0 || statistics.delays != 0 || statistics.handlers_executed != 0)
+		throw std::logic_error{"Disabled statistics are collected, rounds: " + std::to_string(statistics.rounds)};
+}
+
+
+};	// namespace
+
+
+
+int
+main()
+{
+	using poll  = dkuk::async_core::worker::poll;
+	using delay = dkuk::async_core::worker::delay;
+	
+	int status = 0;
+	
+	// run_one blocks on empty context forever, so it isn't checked here.
+	const std::initializer_list<std::pair<poll, poll>> poll_policies = {
+		{poll::disabled, poll::poll_one},
+		{poll::disabled, poll::poll_all},
+		{poll::poll_one, poll::disabled},
+		{poll::poll_one, poll::poll_one},
+		{poll::poll_one, poll::poll_all},
+		{poll::poll_all, poll::disabled},
+		{poll::poll_all, poll::poll_one},
+		{poll::poll_all, poll::poll_all}
+	};
+	
+	for (const auto &poll_policy: poll_policies) {
+		for (const auto delay_policy: {delay::no_delay, delay::yield, delay::sleep}) {
+			try {
+				check_policies(poll_policy.first, poll_policy.second, delay_policy);
+			} catch (const std::exception &e) {
+				std::cout << "Error: " << e.what() << '.' << std::endl;
+				status = 1;
+			}
+		}
+	}
+	
+	try {
+		check_statistics_disabled();
+	} catch (const std::exception &e) {
+		std::cout << "Error: " << e.what() << '.' << std::endl;
+		status = 1;
+	}
+	
+	return status;
+}
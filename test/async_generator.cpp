@@ -0,0 +1,161 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 06:57
+
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/system_timer.hpp>
+
+#include <dkuk/async_generator.hpp>
+#include <dkuk/coroutine.hpp>
+
+
+namespace {
+
+
+constexpr int values_count = 10;
+
+
+};	// namespace
+
+
+
+int
+main()
+{
+	boost::asio::io_context io_context;
+	
+	std::vector<int> values;
+	std::vector<const int *> produced_ptrs, consumed_ptrs;
+	int ticks = 0;
+	bool exception_caught = false, finished = false, other_consumer_rejected = false;
+	
+	// Producer keeps context of the first consumer, so other coroutines can't consume it
+	dkuk::async_generator<int> shared_generator{
+		[](dkuk::async_generator<int>::yield_type yield, dkuk::coroutine_context /* context */)
+		{
+			for (int i = 0; true; ++i)
+				yield(i);
+		}
+	};
+	
+	dkuk::spawn(
+		io_context,
+		[&](dkuk::coroutine_context context)
+		{
+			// Producer waits for timer between values, so other coroutines work meanwhile
+			dkuk::async_generator<int> generator{
+				[&](dkuk::async_generator<int>::yield_type yield, dkuk::coroutine_context context)
+				{
+					boost::asio::system_timer timer{context.get_executor().context()};
+					for (int i = 0; i < values_count; ++i) {
+						timer.expires_from_now(std::chrono::milliseconds{1});
+						timer.async_wait(context);
+						
+						int value = i * i;
+						produced_ptrs.push_back(&value);
+						yield(value);
+					}
+				}
+			};
+			
+			dkuk::spawn(
+				context,
+				[&](dkuk::coroutine_context context)
+				{
+					boost::asio::system_timer timer{context.get_executor().context()};
+					for (int i = 0; i < 3; ++i) {
+						timer.expires_from_now(std::chrono::microseconds{100});
+						timer.async_wait(context);
+						++ticks;
+					}
+				}
+			);
+			
+			while (int *value_ptr = generator.next(context)) {
+				consumed_ptrs.push_back(value_ptr);
+				values.push_back(*value_ptr);
+			}
+			finished = generator.finished() && generator.next(context) == nullptr;
+			
+			dkuk::async_generator<int> failing_generator{
+				[](dkuk::async_generator<int>::yield_type yield, dkuk::coroutine_context /* context */)
+				{
+					yield(1);
+					throw std::runtime_error{"Expected"};
+				}
+			};
+			
+			try {
+				while (failing_generator.next(context) != nullptr)
+					;
+			} catch (const std::runtime_error &) {
+				exception_caught = true;
+			}
+			
+			// Not finished generator is unwound
+			dkuk::async_generator<int> infinite_generator{
+				[](dkuk::async_generator<int>::yield_type yield, dkuk::coroutine_context /* context */)
+				{
+					for (int i = 0; true; ++i)
+						yield(i);
+				}
+			};
+			infinite_generator.next(context);
+			
+			boost::system::error_code ec;
+			shared_generator.next(context);
+			shared_generator.next(context[ec]);	// Same coroutine
+			dkuk::spawn(
+				context,
+				[&](dkuk::coroutine_context context)
+				{
+					try {
+						shared_generator.next(context);
+					} catch (const std::logic_error &) {
+						other_consumer_rejected = true;
+					}
+				}
+			);
+		}
+	);
+	
+	int status = 0;
+	try {
+		io_context.run();
+	} catch (const std::exception &e) {
+		std::cout << "Error: " << e.what() << '.' << std::endl;
+		status = 1;
+	}
+	
+	if (values.size() != values_count || !finished) {
+		std::cout << "Error: Consumed " << values.size() << " values." << std::endl;
+		status = 1;
+	}
+	
+	for (std::size_t i = 0; i < values.size(); ++i) {
+		if (values[i] != static_cast<int>(i * i) || consumed_ptrs[i] != produced_ptrs[i]) {
+			std::cout << "Error: Incorrect value #" << i << ": " << values[i] << '.' << std::endl;
+			status = 1;
+		}
+	}
+	
+	if (ticks != 3) {
+		std::cout << "Error: Other coroutine is blocked: " << ticks << " ticks." << std::endl;
+		status = 1;
+	}
+	
+	if (!exception_caught) {
+		std::cout << "Error: Exception is not rethrown." << std::endl;
+		status = 1;
+	}
+	
+	if (!other_consumer_rejected) {
+		std::cout << "Error: Generator is consumed by another coroutine." << std::endl;
+		status = 1;
+	}
+	
+	return status;
+}
@@ -0,0 +1,149 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 07:18
+
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+
+#include <dkuk/buffer_pool.hpp>
+#include <dkuk/coroutine.hpp>
+
+
+namespace {
+
+
+// Released blocks are reused: first by the same thread, then through the pool's lists.
+void
+check_recycling()
+{
+	boost::asio::io_context io_context;
+	dkuk::buffer_pool &pool = boost::asio::use_service<dkuk::buffer_pool>(io_context);
+	
+	dkuk::pooled_buffer b = pool.acquire(1000);
+	if (b.size() != 1000 || b.capacity() != 1024)
+		throw std::logic_error{"Incorrect size class"};
+	
+	void * const data = b.data();
+	b.release();
+	if (b)
+		throw std::logic_error{"Released buffer is not empty"};
+	
+	b = pool.acquire(600);
+	if (b.data() != data)
+		throw std::logic_error{"Block is not reused from thread cache"};
+	
+	// Big buffers are not pooled
+	const dkuk::pooled_buffer big = pool.acquire(dkuk::buffer_pool::max_size + 1);
+	if (big.capacity() != dkuk::buffer_pool::max_size + 1)
+		throw std::logic_error{"Big buffer is rounded"};
+	
+	if (pool.get_statistics().allocated_count != 1)
+		throw std::logic_error{"Allocated blocks: " + std::to_string(pool.get_statistics().allocated_count)};
+}
+
+
+// Thread cache is shared by pools: block released to one pool is acquired from another one without allocation.
+void
+check_shared_thread_cache()
+{
+	boost::asio::io_context io_context1, io_context2;
+	dkuk::buffer_pool &pool1 = boost::asio::use_service<dkuk::buffer_pool>(io_context1);
+	dkuk::buffer_pool &pool2 = boost::asio::use_service<dkuk::buffer_pool>(io_context2);
+	
+	dkuk::pooled_buffer b = pool1.acquire(2048);
+	void * const data = b.data();
+	b.release();
+	
+	b = pool2.acquire(2048);
+	if (b.data() != data || pool2.get_statistics().allocated_count != 0)
+		throw std::logic_error{"Block is not shared by thread cache"};
+}
+
+
+// Without thread caches blocks released by one thread are acquired by another through the pool.
+void
+check_shared_lists()
+{
+	boost::asio::io_context io_context;
+	dkuk::buffer_pool::parameters parameters;
+	parameters.max_thread_cached = 0;
+	dkuk::buffer_pool &pool = boost::asio::make_service<dkuk::buffer_pool>(io_context, parameters);
+	
+	dkuk::pooled_buffer b = pool.acquire(4096);
+	void * const data = b.data();
+	std::thread{[b = std::move(b)] {}}.join();	// Released by another thread
+	
+	b = pool.acquire(4096);
+	if (b.data() != data)
+		throw std::logic_error{"Block is not reused from the pool"};
+	
+	const dkuk::buffer_pool::statistics statistics = pool.get_statistics();
+	if (statistics.allocated_count != 1 || statistics.acquired_count != 1)
+		throw std::logic_error{"Incorrect pool statistics"};
+}
+
+
+// Pooled buffers are passed to Asio operations directly.
+void
+check_io()
+{
+	const std::string message = "Hello, pooled world!";
+	
+	boost::asio::io_context io_context;
+	boost::asio::local::stream_protocol::socket s1{io_context}, s2{io_context};
+	boost::asio::local::connect_pair(s1, s2);
+	
+	std::string received;
+	dkuk::spawn(
+		io_context,
+		[&](dkuk::coroutine_context context)
+		{
+			dkuk::pooled_buffer b = context.acquire_buffer(message.size());
+			std::memcpy(b.data(), message.data(), message.size());
+			boost::asio::async_write(s1, b.buffer(), context);
+		}
+	);
+	dkuk::spawn(
+		io_context,
+		[&](dkuk::coroutine_context context)
+		{
+			dkuk::pooled_buffer b = context.acquire_buffer(message.size());
+			const std::size_t bytes_transferred = boost::asio::async_read(s2, b.buffer(), context);
+			received.assign(static_cast<const char *>(b.data()), bytes_transferred);
+		}
+	);
+	io_context.run();
+	
+	if (received != message)
+		throw std::logic_error{"Received: \"" + received + '"'};
+}
+
+
+};	// namespace
+
+
+
+int
+main()
+{
+	int status = 0;
+	try {
+		check_recycling();
+		check_shared_thread_cache();
+		check_shared_lists();
+		check_io();
+	} catch (const std::exception &e) {
+		std::cout << "Error: " << e.what() << '.' << std::endl;
+		status = 1;
+	}
+	
+	return status;
+}
@@ -0,0 +1,282 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 06:08
+
+#include <atomic>
+#include <chrono>
+#include <initializer_list>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <boost/asio/post.hpp>
+
+#include <dkuk/async_core.hpp>
+
+
+namespace {
+
+
+void
+busy_wait(
+	std::chrono::nanoseconds duration
+)
+{
+	const auto deadline = std::chrono::steady_clock::now() + duration;
+	while (std::chrono::steady_clock::now() < deadline)
+		;
+}
+
+
+// Task reposts itself, so the context always has ready task.
+void
+post_endless_task(
+	boost::asio::io_context &context,
+	const std::atomic<bool> &stop,
+	std::chrono::nanoseconds cost
+)
+{
+	boost::asio::post(
+		context,
+		[&context, &stop, cost]
+		{
+			busy_wait(cost);
+			if (!stop)
+				post_endless_task(context, stop, cost);
+		}
+	);
+}
+
+
+// Two tenants: one with expensive tasks, another with cheap ones. With Deficit Round-Robin they should get
+// comparable time of the single worker.
+void
+check_fairness()
+{
+	dkuk::async_core::context::parameters context_parameters;
+	context_parameters.quantum = std::chrono::milliseconds{2};
+	
+	dkuk::async_core::worker::parameters worker_parameters;
+	worker_parameters.self_poll_policy     = dkuk::async_core::worker::poll::disabled;
+	worker_parameters.children_poll_policy = dkuk::async_core::worker::poll::poll_one;
+	worker_parameters.delay_policy         = dkuk::async_core::worker::delay::no_delay;
+	worker_parameters.statistics           = true;
+	
+	dkuk::async_core::context_tree t;
+	const auto root      = t.add_context(0, 0);
+	const auto expensive = t.add_context(root, 0);
+	const auto cheap     = t.add_context(root, 0);
+	t.set_context_parameters(expensive, context_parameters);
+	t.set_context_parameters(cheap, context_parameters);
+	t.add_worker(root, worker_parameters);
+	
+	dkuk::async_core core{t, false};
+	
+	std::atomic<bool> stop{false};
+	post_endless_task(core.get_io_context(expensive), stop, std::chrono::milliseconds{1});
+	post_endless_task(core.get_io_context(cheap), stop, std::chrono::microseconds{10});
+	
+	core.start();
+	std::this_thread::sleep_for(std::chrono::milliseconds{500});
+	stop = true;
+	core.stop();
+	
+	const auto expensive_statistics = core.get_context_statistics(expensive);
+	const auto cheap_statistics     = core.get_context_statistics(cheap);
+	
+	if (expensive_statistics.handlers_executed == 0 || cheap_statistics.handlers_executed == 0)
+		throw std::logic_error{"Fairness: some tenant is starved"};
+	
+	// Skipped contexts are not counted as executed handlers
+	const std::size_t handlers_executed = core.get_worker_statistics(root).handlers_executed;
+	if (handlers_executed != expensive_statistics.handlers_executed + cheap_statistics.handlers_executed)
+		throw std::logic_error{"Fairness: worker executed " + std::to_string(handlers_executed) + " handlers"};
+	
+	// Without scheduling cheap tenant gets ~1% of time
+	const double ratio =
+		static_cast<double>(cheap_statistics.execution_time.count())
+		/ static_cast<double>(expensive_statistics.execution_time.count());
+	if (ratio < 0.5 || ratio > 2)
+		throw std::logic_error{
+			"Fairness: cheap tenant time: " + std::to_string(cheap_statistics.execution_time.count())
+			+ " ns, expensive tenant time: " + std::to_string(expensive_statistics.execution_time.count()) + " ns"
+		};
+}
+
+
+// Background context with rate limits only: limits hold, even if workers are idle otherwise.
+void
+check_rate_limits(
+	const dkuk::async_core::context::parameters &context_parameters,
+	std::chrono::nanoseconds cost,
+	std::size_t min_handlers,
+	std::size_t max_handlers,
+	std::chrono::nanoseconds min_time,
+	std::chrono::nanoseconds max_time
+)
+{
+	dkuk::async_core::worker::parameters worker_parameters;
+	worker_parameters.self_poll_policy = dkuk::async_core::worker::poll::disabled;
+	worker_parameters.delay_policy     = dkuk::async_core::worker::delay::sleep;
+	worker_parameters.delay_value      = std::chrono::microseconds{100};
+	
+	dkuk::async_core::context_tree t;
+	const auto root       = t.add_context(0, 0);
+	const auto background = t.add_context(root, 0, context_parameters);
+	t.add_worker(root, worker_parameters);
+	
+	dkuk::async_core core{t, false};
+	
+	std::atomic<bool> stop{false};
+	post_endless_task(core.get_io_context(background), stop, cost);
+	
+	core.start();
+	std::this_thread::sleep_for(std::chrono::milliseconds{500});
+	stop = true;
+	core.stop();
+	
+	const auto statistics = core.get_context_statistics(background);
+	if (statistics.handlers_executed < min_handlers || statistics.handlers_executed > max_handlers
+		|| statistics.execution_time < min_time || statistics.execution_time > max_time)
+		throw std::logic_error{
+			"Rate limits: executed " + std::to_string(statistics.handlers_executed) + " tasks in "
+			+ std::to_string(statistics.execution_time.count()) + " ns"
+		};
+}
+
+
+void
+check_handlers_rate()
+{
+	dkuk::async_core::context::parameters context_parameters;
+	context_parameters.handlers_per_second = 200;
+	context_parameters.handlers_burst      = 10;
+	
+	// ~100 tasks in 500 ms + burst
+	check_rate_limits(
+		context_parameters, std::chrono::nanoseconds::zero(),
+		50, 160,
+		std::chrono::nanoseconds::zero(), std::chrono::milliseconds{100}
+	);
+}
+
+
+void
+check_cpu_share()
+{
+	dkuk::async_core::context::parameters context_parameters;
+	context_parameters.cpu_share = 0.25;
+	context_parameters.cpu_burst = std::chrono::milliseconds{5};
+	
+	// ~125 ms of 500 ms
+	check_rate_limits(
+		context_parameters, std::chrono::milliseconds{1},
+		50, 250,
+		std::chrono::milliseconds{60}, std::chrono::milliseconds{250}
+	);
+}
+
+
+// Accounting only: no tasks are skipped, statistics are collected.
+void
+check_accounting()
+{
+	constexpr std::size_t tasks_count = 100;
+	
+	dkuk::async_core::context::parameters context_parameters;
+	context_parameters.accounting = true;
+	
+	dkuk::async_core::context_tree t;
+	t.add_context(0, 0);
+	
+	dkuk::async_core core{t, false};
+	const auto context_id = core.add_context(0, {dkuk::async_core::worker::parameters{}}, context_parameters);
+	const auto plain_id   = core.add_context(0, 1);
+	
+	std::atomic<std::size_t> executed{0};
+	for (std::size_t i = 0; i < tasks_count; ++i) {
+		boost::asio::post(core.get_io_context(context_id), [&executed] { ++executed; });
+		boost::asio::post(core.get_io_context(plain_id), [&executed] { ++executed; });
+	}
+	
+	core.start();
+	
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+	while (executed < 2 * tasks_count && std::chrono::steady_clock::now() < deadline)
+		std::this_thread::sleep_for(std::chrono::milliseconds{1});
+	
+	core.stop();
+	
+	const auto statistics = core.get_context_statistics(context_id);
+	if (executed != 2 * tasks_count || statistics.handlers_executed != tasks_count)
+		throw std::logic_error{
+			"Accounting: executed " + std::to_string(executed.load()) + ", accounted "
+			+ std::to_string(statistics.handlers_executed)
+		};
+	
+	if (core.get_context_statistics(plain_id).handlers_executed != 0)
+		throw std::logic_error{"Accounting: context without accounting has statistics"};
+}
+
+
+// Worker with run_one policy doesn't block in empty scheduled context (it is polled with poll_one instead),
+// so it runs the next context.
+void
+check_run_one_policy()
+{
+	constexpr std::size_t tasks_count = 100;
+	
+	dkuk::async_core::context::parameters context_parameters;
+	context_parameters.quantum = std::chrono::milliseconds{1};
+	
+	dkuk::async_core::worker::parameters worker_parameters;
+	worker_parameters.self_poll_policy     = dkuk::async_core::worker::poll::disabled;
+	worker_parameters.children_poll_policy = dkuk::async_core::worker::poll::run_one;
+	
+	dkuk::async_core::context_tree t;
+	const auto root      = t.add_context(0, 0);
+	t.add_context(root, 0, context_parameters);	// Empty
+	const auto plain = t.add_context(root, 0);
+	t.add_worker(root, worker_parameters);
+	
+	dkuk::async_core core{t, false};
+	
+	std::atomic<std::size_t> executed{0};
+	for (std::size_t i = 0; i < tasks_count; ++i)
+		boost::asio::post(core.get_io_context(plain), [&executed] { ++executed; });
+	
+	core.start();
+	
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+	while (executed < tasks_count && std::chrono::steady_clock::now() < deadline)
+		std::this_thread::sleep_for(std::chrono::milliseconds{1});
+	
+	core.stop();
+	
+	if (executed != tasks_count)
+		throw std::logic_error{"Run one: worker is blocked in scheduled context"};
+}
+
+
+};	// namespace
+
+
+
+int
+main()
+{
+	int status = 0;
+	
+	for (
+		const auto &check:
+		{check_fairness, check_handlers_rate, check_cpu_share, check_accounting, check_run_one_policy}
+	) {
+		try {
+			check();
+		} catch (const std::exception &e) {
+			std::cout << "Error: " << e.what() << '.' << std::endl;
+			status = 1;
+		}
+	}
+	
+	return status;
+}
@@ -0,0 +1,144 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 05:58
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include <boost/asio/detail/scheduler.hpp>
+#include <boost/version.hpp>
+
+#include <dkuk/async_core.hpp>
+
+
+namespace {
+
+
+void
+check_runners_count(
+	const dkuk::async_core::context_tree &t,
+	dkuk::async_core::context_id_type context_id,
+	std::size_t expected
+)
+{
+	const std::size_t runners_count = t.get_runners_count(context_id);
+	if (runners_count != expected)
+		throw std::logic_error{
+			"Context " + std::to_string(context_id) + ": expected runners: " + std::to_string(expected)
+			+ ", but got: " + std::to_string(runners_count)
+		};
+}
+
+
+void
+check_concurrency_hint(
+	const dkuk::async_core &core,
+	dkuk::async_core::context_id_type context_id,
+	int expected
+)
+{
+	const int concurrency_hint = core.get_concurrency_hint(context_id);
+	if (concurrency_hint != expected)
+		throw std::logic_error{
+			"Context " + std::to_string(context_id) + ": expected concurrency hint: " + std::to_string(expected)
+			+ ", but got: " + std::to_string(concurrency_hint)
+		};
+
+#if BOOST_VERSION >= 107400	// Scheduler exposes its hint
+	auto &io_context = const_cast<boost::asio::io_context &>(core.get_io_context(context_id));
+	if (boost::asio::use_service<boost::asio::detail::scheduler>(io_context).concurrency_hint() != expected)
+		throw std::logic_error{"Context " + std::to_string(context_id) + ": hint is not applied to io_context"};
+#endif	// BOOST_VERSION >= 107400
+}
+
+
+template<class F>
+void
+check_rejected(
+	F f
+)
+{
+	try {
+		f();
+	} catch (const std::invalid_argument &) {
+		return;
+	}
+	throw std::logic_error{"Unsafe concurrency hint is accepted"};
+}
+
+
+};	// namespace
+
+
+
+int
+main()
+{
+	dkuk::async_core::worker::parameters self_only;
+	self_only.children_poll_policy = dkuk::async_core::worker::poll::disabled;
+	
+	dkuk::async_core::worker::parameters children_only;
+	children_only.self_poll_policy = dkuk::async_core::worker::poll::disabled;
+	
+	
+	dkuk::async_core::context_tree t;
+	const auto root     = t.add_context(0, 2);				// 2 common workers
+	const auto lw       = t.add_context(root, 1);			// + 1 own worker
+	const auto hw       = t.add_context(root, 0);
+	const auto hw_leaf  = t.add_context(hw, 0);
+	const auto disabled = t.add_context(root, 1, false);
+	const auto isolated = t.add_context(disabled, 0);
+	t.add_worker(hw, self_only);
+	t.add_worker(hw, children_only);
+	
+	dkuk::async_core::context_tree u;
+	const auto u_root = u.add_context(0, 0);
+	const auto u_leaf = u.add_context(u_root, 0);
+	u.add_worker(u_root, self_only);
+	u.add_worker(u_leaf, self_only);
+	
+	
+	try {
+		check_runners_count(t, root,     2);
+		check_runners_count(t, lw,       3);
+		check_runners_count(t, hw,       3);	// Common workers + self_only
+		check_runners_count(t, hw_leaf,  3);	// Common workers + children_only
+		check_runners_count(t, disabled, 0);
+		check_runners_count(t, isolated, 3);	// Common workers + worker of disabled context
+		
+		check_runners_count(u, u_root,   1);
+		check_runners_count(u, u_leaf,   1);
+		
+		
+		// Cores with automatic and explicit hints should work as usual
+		const auto explicit_hint = t.add_context(lw, 0, true, 4);
+		dkuk::async_core core_t{t};
+		dkuk::async_core core_u{u};
+		
+		check_concurrency_hint(core_t, root,          BOOST_ASIO_CONCURRENCY_HINT_DEFAULT);
+		check_concurrency_hint(core_t, disabled,      BOOST_ASIO_CONCURRENCY_HINT_DEFAULT);
+		check_concurrency_hint(core_t, explicit_hint, 4);
+		check_concurrency_hint(core_u, u_root,        BOOST_ASIO_CONCURRENCY_HINT_1);
+		check_concurrency_hint(core_u, u_leaf,        BOOST_ASIO_CONCURRENCY_HINT_1);
+		
+		// Contexts added to running core
+		const auto added_single = core_u.add_context(u_leaf, 1);
+		const auto added_shared = core_t.add_context(root, 1);
+		check_concurrency_hint(core_u, added_single, BOOST_ASIO_CONCURRENCY_HINT_1);
+		check_concurrency_hint(core_t, added_shared, BOOST_ASIO_CONCURRENCY_HINT_DEFAULT);
+		
+		u.set_single_worker_concurrency_hint(boost::none);
+		dkuk::async_core core_u_no_hint{u};
+		check_concurrency_hint(core_u_no_hint, u_leaf, BOOST_ASIO_CONCURRENCY_HINT_DEFAULT);
+		
+		// Core posts to contexts from other threads, so scheduler locking can't be disabled
+		check_rejected([&u] { u.set_single_worker_concurrency_hint(BOOST_ASIO_CONCURRENCY_HINT_UNSAFE); });
+		check_rejected([&u, u_root] { u.add_context(u_root, 0, true, BOOST_ASIO_CONCURRENCY_HINT_UNSAFE); });
+		check_rejected([&core_u, u_root] { core_u.add_context(u_root, 0, true, BOOST_ASIO_CONCURRENCY_HINT_UNSAFE); });
+		u.set_single_worker_concurrency_hint(BOOST_ASIO_CONCURRENCY_HINT_UNSAFE_IO);
+	} catch (const std::exception &e) {
+		std::cout << "Error: " << e.what() << '.' << std::endl;
+		return 1;
+	}
+	
+	return 0;
+}
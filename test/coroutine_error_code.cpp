@@ -0,0 +1,199 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 07:42
+
+#include <future>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <dkuk/coroutine.hpp>
+
+
+namespace {
+
+
+// Completes the handler before the initiating function returns (before the coroutine suspends).
+template<class Handler>
+auto
+async_complete_immediately(
+	boost::system::error_code ec,
+	int value,
+	Handler &&handler
+)
+{
+	boost::asio::async_completion<Handler, void (boost::system::error_code, int)> init{handler};
+	init.completion_handler(ec, value);
+	return init.result.get();
+}
+
+
+// Completes a copy of the handler in another io_context. If wait is set, completion is finished before the
+// coroutine suspends, otherwise they race.
+template<class Signature, class Handler, class... Args>
+auto
+async_complete_in(
+	boost::asio::io_context &io_context,
+	bool wait,
+	Handler &&handler,
+	Args... args
+)
+{
+	boost::asio::async_completion<Handler, Signature> init{handler};
+	std::promise<void> completed_promise;
+	std::future<void> completed_future = completed_promise.get_future();
+	boost::asio::post(
+		io_context,
+		[handler = init.completion_handler, completed_promise = std::move(completed_promise), args...]() mutable
+		{
+			handler(args...);	// Copy keeps external error code
+			completed_promise.set_value();
+		}
+	);
+	if (wait)
+		completed_future.wait();
+	return init.result.get();
+}
+
+
+// context[ec] receives the error of an operation instead of exception.
+void
+check_external_error_code()
+{
+	boost::asio::io_context io_context;
+	boost::asio::local::stream_protocol::socket s1{io_context}, s2{io_context};
+	boost::asio::local::connect_pair(s1, s2);
+	s2.close();
+	
+	boost::system::error_code ec;
+	std::size_t bytes_transferred = 1;
+	dkuk::spawn(
+		io_context,
+		[&](dkuk::coroutine_context context)
+		{
+			char c;
+			bytes_transferred = s1.async_read_some(boost::asio::buffer(&c, 1), context[ec]);
+		}
+	);
+	io_context.run();
+	
+	if (ec != boost::asio::error::eof || bytes_transferred != 0)
+		throw std::logic_error{"Incorrect read result: " + ec.message()};
+}
+
+
+// Result of operation, completed before the coroutine suspends, is not lost.
+void
+check_early_completion()
+{
+	boost::asio::io_context io_context;
+	
+	int value = 0, value_with_ec = 0;
+	boost::system::error_code ec;
+	dkuk::spawn(
+		io_context,
+		[&](dkuk::coroutine_context context)
+		{
+			value = async_complete_immediately({}, 1, context);
+			value_with_ec = async_complete_immediately(boost::asio::error::eof, 2, context[ec]);
+		}
+	);
+	io_context.run();
+	
+	if (value != 1 || value_with_ec != 2 || ec != boost::asio::error::eof)
+		throw std::logic_error{"Result of early completed operation is lost"};
+}
+
+
+// Results (and errors for context[ec]) of operations completed by another thread are not lost, whichever of
+// completion and suspension is the first.
+void
+check_cross_thread_completion()
+{
+	constexpr int iterations = 10000;
+	
+	boost::asio::io_context io_context, other_io_context;
+	auto work_guard = boost::asio::make_work_guard(io_context);	// Operations are outstanding in other_io_context
+	auto other_work_guard = boost::asio::make_work_guard(other_io_context);
+	std::thread other_thread{[&other_io_context] { other_io_context.run(); }};
+	
+	const boost::system::error_code eof = boost::asio::error::eof;
+	int mismatches = 0;
+	bool finished = false;
+	dkuk::spawn(
+		io_context,
+		[&](dkuk::coroutine_context context)
+		{
+			for (int i = 0; i < iterations; ++i) {
+				const bool wait = i % 2 == 0;
+				async_complete_in<void ()>(other_io_context, wait, context);
+				
+				if (async_complete_in<void (int)>(other_io_context, wait, context, i) != i)
+					++mismatches;
+				
+				const auto values = async_complete_in<void (int, int)>(other_io_context, wait, context, i, i + 1);
+				if (values != std::make_tuple(i, i + 1))
+					++mismatches;
+				
+				boost::system::error_code ec;
+				async_complete_in<void (boost::system::error_code)>(other_io_context, wait, context[ec], eof);
+				if (ec != eof)
+					++mismatches;
+				
+				ec = {};
+				const int value =
+					async_complete_in<void (boost::system::error_code, int)>(
+						other_io_context,
+						wait,
+						context[ec],
+						eof,
+						i
+					);
+				if (value != i || ec != eof)
+					++mismatches;
+			}
+			
+			finished = true;
+			work_guard.reset();
+		}
+	);
+	io_context.run();
+	
+	other_work_guard.reset();
+	other_thread.join();
+	
+	if (!finished)
+		throw std::logic_error{"Cross thread completion: coroutine is not finished"};
+	if (mismatches != 0)
+		throw std::logic_error{"Cross thread completion: " + std::to_string(mismatches) + " results lost"};
+}
+
+
+};	// namespace
+
+
+
+int
+main()
+{
+	int status = 0;
+	try {
+		check_external_error_code();
+		check_early_completion();
+		check_cross_thread_completion();
+	} catch (const std::exception &e) {
+		std::cout << "Error: " << e.what() << '.' << std::endl;
+		status = 1;
+	}
+	
+	return status;
+}
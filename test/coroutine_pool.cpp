@@ -0,0 +1,94 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 06:28
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/system_timer.hpp>
+
+#include <dkuk/coroutine_pool.hpp>
+
+
+namespace {
+
+
+constexpr std::size_t pool_size = 4, tasks_count = 100, threads_count = 2;
+
+
+};	// namespace
+
+
+
+int
+main()
+{
+	boost::asio::io_context io_context;
+	
+	std::atomic<std::size_t> executed{0}, running{0}, max_running{0};
+	{
+		dkuk::coroutine_pool pool{io_context, pool_size};
+		
+		pool.post([](dkuk::coroutine_context) { throw std::runtime_error{"As expected"}; });
+		for (std::size_t i = 0; i < tasks_count; ++i) {
+			std::unique_ptr<std::size_t> delay_ptr{new std::size_t{i % 3}};	// Move-only task
+			pool.post(
+				[&, delay_ptr = std::move(delay_ptr)](dkuk::coroutine_context context)
+				{
+					const std::size_t now_running = ++running;
+					std::size_t prev_max = max_running;
+					while (prev_max < now_running && !max_running.compare_exchange_weak(prev_max, now_running))
+						;
+					
+					// Suspend: other tasks may run meanwhile
+					boost::asio::system_timer timer{
+						context.get_executor().context(),
+						std::chrono::milliseconds{*delay_ptr}
+					};
+					timer.async_wait(context);
+					
+					--running;
+					++executed;
+				}
+			);
+		}
+		
+		std::size_t exceptions = 0;
+		std::vector<std::thread> threads;
+		for (std::size_t i = 0; i < threads_count; ++i)
+			threads.emplace_back(
+				[&]
+				{
+					while (executed < tasks_count) {
+						try {
+							io_context.run_one_for(std::chrono::milliseconds{10});
+						} catch (const std::runtime_error &) {
+							++exceptions;
+						}
+					}
+				}
+			);
+		for (auto &thread: threads)
+			thread.join();
+		
+		if (exceptions != 1) {
+			std::cout << "Error: exceptions caught: " << exceptions << '.' << std::endl;
+			return 1;
+		}
+	}
+	io_context.restart();
+	io_context.run();	// Parked coroutines finish
+	
+	if (executed != tasks_count || max_running > pool_size || max_running == 0) {
+		std::cout << "Error: executed " << executed << " tasks, max running: " << max_running << '.' << std::endl;
+		return 1;
+	}
+	
+	return 0;
+}
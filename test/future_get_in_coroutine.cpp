@@ -0,0 +1,127 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 06:36
+
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/system_timer.hpp>
+
+#include <dkuk/coroutine.hpp>
+
+
+namespace {
+
+
+int
+compute(
+	int x,
+	dkuk::coroutine_context context
+)
+{
+	boost::asio::system_timer timer{context.get_executor().context(), std::chrono::milliseconds{10}};
+	timer.async_wait(context);
+	return x * 2;
+}
+
+
+int
+fail(
+	dkuk::coroutine_context context
+)
+{
+	boost::asio::system_timer timer{context.get_executor().context(), std::chrono::milliseconds{10}};
+	timer.async_wait(context);
+	throw std::runtime_error{"Expected"};
+}
+
+
+};	// namespace
+
+
+
+int
+main()
+{
+	// Single thread: blocking get() would deadlock here
+	boost::asio::io_context io_context;
+	
+	int result = 0, ticks = 0, thread_result = 0;
+	bool exception_caught = false;
+	
+	dkuk::spawn(
+		io_context,
+		[&](dkuk::coroutine_context context)
+		{
+			auto result_future = dkuk::spawn_with_future(context, compute, 21);
+			
+			// Other coroutines work, while this one waits
+			dkuk::spawn(
+				context,
+				[&](dkuk::coroutine_context context)
+				{
+					boost::asio::system_timer timer{context.get_executor().context()};
+					for (int i = 0; i < 3; ++i) {
+						timer.expires_from_now(std::chrono::milliseconds{1});
+						timer.async_wait(context);
+						++ticks;
+					}
+				}
+			);
+			
+			result = result_future.get(context);
+			
+			try {
+				dkuk::spawn_with_future(context, fail).get(context);
+			} catch (const std::runtime_error &) {
+				exception_caught = true;
+			}
+			
+			// Promise is satisfied from another thread
+			dkuk::coroutine_promise<int> promise{io_context};
+			auto thread_future = promise.get_future();
+			std::thread thread{
+				[&promise]
+				{
+					std::this_thread::sleep_for(std::chrono::milliseconds{10});
+					promise.set_value(7);
+				}
+			};
+			thread_future.wait(context);
+			thread_result = thread_future.get(context);
+			thread.join();
+			
+			// Ready future doesn't suspend
+			dkuk::coroutine_promise<void> ready_promise{io_context};
+			ready_promise.set_value();
+			ready_promise.get_future().get(context);
+		}
+	);
+	
+	int status = 0;
+	try {
+		io_context.run();
+	} catch (const std::exception &e) {
+		std::cout << "Error: " << e.what() << '.' << std::endl;
+		status = 1;
+	}
+	
+	if (result != 42 || thread_result != 7) {
+		std::cout << "Error: Incorrect results: " << result << ", " << thread_result << '.' << std::endl;
+		status = 1;
+	}
+	
+	if (ticks != 3) {
+		std::cout << "Error: Other coroutine is blocked: " << ticks << " ticks." << std::endl;
+		status = 1;
+	}
+	
+	if (!exception_caught) {
+		std::cout << "Error: Exception is not rethrown." << std::endl;
+		status = 1;
+	}
+	
+	return status;
+}
@@ -0,0 +1,72 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 06:38
+
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+
+#include <dkuk/coroutine.hpp>
+
+
+int
+main()
+{
+	constexpr std::size_t waiters_count = 4;
+	
+	boost::asio::io_context io_context;
+	dkuk::coroutine_promise<int> promise{io_context};
+	const auto future = promise.get_future().share();
+	
+	int status = 0;
+	
+	if (future.wait_for(std::chrono::milliseconds{10}) != std::future_status::timeout
+		|| future.wait_until(std::chrono::steady_clock::now() + std::chrono::milliseconds{10})
+			!= std::future_status::timeout) {
+		std::cout << "Error: Unsatisfied future is ready." << std::endl;
+		status = 1;
+	}
+	
+	// Blocked threads are woken up by set_value()
+	std::vector<int> results(waiters_count, 0);
+	std::vector<std::thread> waiters;
+	for (std::size_t i = 0; i < waiters_count; ++i)
+		waiters.emplace_back(
+			[&future, &result = results[i], i]
+			{
+				switch (i % 3) {
+					case 0:
+						future.wait();
+						break;
+					case 1:
+						future.wait_for(std::chrono::seconds{10});
+						break;
+					default:
+						future.wait_until(std::chrono::system_clock::now() + std::chrono::seconds{10});
+						break;
+				}
+				result = future.get();
+			}
+		);
+	
+	std::this_thread::sleep_for(std::chrono::milliseconds{10});
+	promise.set_value(42);
+	for (auto &waiter: waiters)
+		waiter.join();
+	
+	for (const int result: results) {
+		if (result != 42) {
+			std::cout << "Error: Incorrect result: " << result << '.' << std::endl;
+			status = 1;
+		}
+	}
+	
+	if (future.wait_until(std::chrono::steady_clock::now()) != std::future_status::ready) {
+		std::cout << "Error: Satisfied future is not ready." << std::endl;
+		status = 1;
+	}
+	
+	return status;
+}
@@ -0,0 +1,360 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 07:59
+
+// Performance regression gate: key microbenchmarks compared with checked-in baseline (perf_regression.baseline).
+// Each measurement is the best of several runs in nanoseconds per operation, divided by the same value of
+// calibration loop (allocation and indirect call, no library code), so baseline ratios don't depend on the machine's
+// speed. Test fails, if any ratio exceeds its baseline more than tolerance times (third column of baseline,
+// default: 2).
+//
+// Usage: perf_regression <baseline file> [--update]
+// --update rewrites baseline with current ratios (release build).
+//
+// NOTE: Timings of unoptimized builds are meaningless, so the gate is skipped, if NDEBUG isn't defined. This matters
+//       for manual builds only: b2 always builds the gate in release variant (see jamfile.jam).
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+
+#include <dkuk/async_core.hpp>
+#include <dkuk/coroutine.hpp>
+
+
+namespace {
+
+
+constexpr std::size_t runs_count        = 5;
+constexpr double      default_tolerance = 2;
+
+
+
+struct baseline_entry
+{
+	double ratio;	// To calibration
+	double tolerance;
+};	// struct baseline_entry
+
+
+using baseline = std::map<std::string, baseline_entry>;
+
+
+baseline
+read_baseline(
+	const std::string &path
+)
+{
+	std::ifstream file{path};
+	if (!file)
+		throw std::runtime_error{"Can't read baseline: " + path};
+	
+	baseline res;
+	std::string line;
+	while (std::getline(file, line)) {
+		if (line.empty() || line[0] == '#')
+			continue;
+		
+		std::istringstream stream{line};
+		std::string name;
+		baseline_entry entry{0, default_tolerance};
+		if (!(stream >> name >> entry.ratio))
+			throw std::runtime_error{"Incorrect baseline line: " + line};
+		stream >> entry.tolerance;
+		res[name] = entry;
+	}
+	return res;
+}
+
+
+void
+write_baseline(
+	const std::string &path,
+	const baseline &b
+)
+{
+	std::ofstream file{path};
+	file
+		<< "# Performance baseline of perf_regression test: <name> <ratio to calibration> [<tolerance>]."
+		<< std::endl
+		<< "# Update (release build): perf_regression perf_regression.baseline --update"
+		<< std::endl;
+	for (const auto &p: b)
+		file
+			<< std::left << std::setw(20) << p.first << std::right
+			<< std::fixed << std::setprecision(2) << std::setw(10) << p.second.ratio
+			<< std::setprecision(1) << std::setw(6) << p.second.tolerance << std::endl;
+	if (!file)
+		throw std::runtime_error{"Can't write baseline: " + path};
+}
+
+
+
+// Best of several runs. Measurement returns nanoseconds per operation.
+double
+best_of_runs(
+	const std::function<double ()> &measurement
+)
+{
+	double res = measurement();
+	for (std::size_t i = 1; i < runs_count; ++i)
+		res = std::min(res, measurement());
+	return res;
+}
+
+
+template<class Duration>
+double
+per_operation_ns(
+	Duration duration,
+	std::size_t operations_count
+)
+{
+	return std::chrono::duration<double, std::nano>{duration}.count() / operations_count;
+}
+
+
+
+// Allocation, indirect call and deallocation of small object: typical costs of the measured operations.
+double
+measure_calibration()
+{
+	constexpr std::size_t iterations = 1000000;
+	
+	std::size_t sum = 0;
+	const std::function<void (std::size_t &)> fn = [](std::size_t &value) { ++value; };
+	const auto start = std::chrono::steady_clock::now();
+	for (std::size_t i = 0; i < iterations; ++i) {
+		const std::unique_ptr<volatile std::size_t> ptr{new volatile std::size_t{i}};
+		fn(sum);
+		sum += *ptr;
+	}
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	if (sum == 0)	// Result is used: loop is not optimized out
+		throw std::logic_error{"Calibration sum is zero"};
+	return per_operation_ns(elapsed, iterations);
+}
+
+
+// Handler, which reposts itself until counter is exhausted.
+class repost
+{
+public:
+	repost(
+		boost::asio::io_context &io_context,
+		std::size_t &left
+	) noexcept:
+		io_context_ptr_{&io_context},
+		left_ptr_{&left}
+	{}
+	
+	
+	void
+	operator()() const
+	{
+		if (--*this->left_ptr_ != 0)
+			boost::asio::post(*this->io_context_ptr_, *this);
+	}
+private:
+	boost::asio::io_context *io_context_ptr_;
+	std::size_t *left_ptr_;
+};	// class repost
+
+
+// Post and execution of handler in one thread.
+double
+measure_post_latency()
+{
+	constexpr std::size_t posts_count = 200000;
+	
+	boost::asio::io_context io_context{1};
+	std::size_t left = posts_count;
+	const auto start = std::chrono::steady_clock::now();
+	boost::asio::post(io_context, repost{io_context, left});
+	io_context.run();
+	return per_operation_ns(std::chrono::steady_clock::now() - start, posts_count);
+}
+
+
+// Spawn and completion of empty coroutine (spawned by batches, so stacks are reused).
+double
+measure_spawn_cost()
+{
+	constexpr std::size_t spawns_count = 20000, batch_size = 100;
+	
+	boost::asio::io_context io_context{1};
+	const auto start = std::chrono::steady_clock::now();
+	for (std::size_t i = 0; i < spawns_count / batch_size; ++i) {
+		for (std::size_t j = 0; j < batch_size; ++j)
+			dkuk::spawn(io_context, [](dkuk::coroutine_context) {});
+		io_context.run();
+		io_context.restart();
+	}
+	return per_operation_ns(std::chrono::steady_clock::now() - start, spawns_count);
+}
+
+
+// Suspend/resume round trip of coroutine through post().
+double
+measure_coroutine_switch()
+{
+	constexpr std::size_t switches_count = 200000;
+	
+	boost::asio::io_context io_context{1};
+	dkuk::spawn(
+		io_context,
+		[&io_context](dkuk::coroutine_context context)
+		{
+			for (std::size_t i = 0; i < switches_count; ++i)
+				boost::asio::post(io_context, context);
+		}
+	);
+	const auto start = std::chrono::steady_clock::now();
+	io_context.run();
+	return per_operation_ns(std::chrono::steady_clock::now() - start, switches_count);
+}
+
+
+// Coroutine spawns another one with future and waits for its result.
+double
+measure_future_completion()
+{
+	constexpr std::size_t futures_count = 20000;
+	
+	boost::asio::io_context io_context{1};
+	std::size_t sum = 0;
+	dkuk::spawn(
+		io_context,
+		[&sum](dkuk::coroutine_context context)
+		{
+			for (std::size_t i = 0; i < futures_count; ++i)
+				sum += dkuk::spawn_with_future(context, [](dkuk::coroutine_context) { return 1; }).get(context);
+		}
+	);
+	const auto start = std::chrono::steady_clock::now();
+	io_context.run();
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	if (sum != futures_count)
+		throw std::logic_error{"Futures completed: " + std::to_string(sum)};
+	return per_operation_ns(elapsed, futures_count);
+}
+
+
+// One round of worker over empty root and its children (see async_core::worker::statistics). Only steady state
+// is measured: rounds are counted in a window after warming up, without start and stop of the core.
+double
+measure_poll_round()
+{
+	constexpr std::chrono::milliseconds warm_up{10}, window{50};
+	constexpr std::size_t children_count = 8;
+	
+	dkuk::async_core::worker::parameters parameters;
+	parameters.self_poll_policy     = dkuk::async_core::worker::poll::poll_one;
+	parameters.children_poll_policy = dkuk::async_core::worker::poll::poll_one;
+	parameters.delay_policy         = dkuk::async_core::worker::delay::no_delay;
+	parameters.statistics           = true;
+	
+	dkuk::async_core::context_tree t;
+	const auto root = t.add_context(0, 0);
+	for (std::size_t i = 0; i < children_count; ++i)
+		t.add_context(root, 0);
+	t.add_worker(root, parameters);
+	
+	dkuk::async_core core{t, true};
+	std::this_thread::sleep_for(warm_up);
+	
+	// Counters are published every 1024 rounds: error is negligible for the window
+	const auto start = std::chrono::steady_clock::now();
+	const std::size_t start_rounds = core.get_worker_statistics(root).rounds;
+	std::this_thread::sleep_for(window);
+	const std::size_t rounds = core.get_worker_statistics(root).rounds - start_rounds;
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	core.stop();
+	
+	if (rounds == 0)
+		throw std::logic_error{"Worker made no rounds"};
+	return per_operation_ns(elapsed, rounds);
+}
+
+
+};	// namespace
+
+
+
+int
+main(
+	int argc,
+	char **argv
+)
+{
+	if (argc < 2 || argc > 3 || (argc == 3 && std::string{argv[2]} != "--update")) {
+		std::cout << "Usage: " << argv[0] << " <baseline file> [--update]" << std::endl;
+		return 1;
+	}
+
+#ifndef NDEBUG	// Manual unoptimized build (b2 forces release variant)
+	std::cout << "Performance regression gate is skipped: build is not optimized (NDEBUG is not defined)." << std::endl;
+	return 0;
+#endif	// NDEBUG
+
+	const std::string baseline_path = argv[1];
+	const bool update = argc == 3;
+	
+	const std::vector<std::pair<std::string, std::function<double ()>>> measurements = {
+		{"post_latency",      measure_post_latency},
+		{"spawn_cost",        measure_spawn_cost},
+		{"coroutine_switch",  measure_coroutine_switch},
+		{"future_completion", measure_future_completion},
+		{"poll_round",        measure_poll_round}
+	};
+	
+	int status = 0;
+	try {
+		baseline b = read_baseline(baseline_path);
+		const double calibration_ns = best_of_runs(measure_calibration);
+		std::cout << std::left << std::setw(20) << "calibration" << std::right << std::fixed << std::setprecision(1)
+			<< std::setw(10) << calibration_ns << " ns" << std::endl;
+		
+		for (const auto &p: measurements) {
+			const double nanoseconds = best_of_runs(p.second), ratio = nanoseconds / calibration_ns;
+			
+			const auto it = b.find(p.first);
+			std::cout << std::left << std::setw(20) << p.first << std::right << std::fixed << std::setprecision(1)
+				<< std::setw(10) << nanoseconds << " ns, ratio: " << std::setprecision(2) << ratio;
+			if (update) {
+				const double tolerance = (it == b.end())? default_tolerance: it->second.tolerance;
+				b[p.first] = baseline_entry{ratio, tolerance};
+			} else if (it == b.end()) {
+				std::cout << " (no baseline)";
+			} else {
+				const double limit = it->second.ratio * it->second.tolerance;
+				std::cout << ", baseline: " << it->second.ratio << ", limit: " << limit;
+				if (ratio > limit) {
+					std::cout << " REGRESSION";
+					status = 1;
+				}
+			}
+			std::cout << std::endl;
+		}
+		
+		if (update)
+			write_baseline(baseline_path, b);
+	} catch (const std::exception &e) {
+		std::cout << "Error: " << e.what() << '.' << std::endl;
+		status = 1;
+	}
+	
+	return status;
+}
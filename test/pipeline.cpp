@@ -0,0 +1,161 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 07:05
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dkuk/async_core.hpp>
+#include <dkuk/pipeline.hpp>
+
+
+namespace {
+
+
+constexpr std::size_t items_count = 10000, batch_size = 100;
+
+
+// Bounded stage served by the parent's workers only could deadlock them in handoffs, so it is rejected.
+bool
+bounded_stage_without_workers_rejected(
+	dkuk::async_core &core,
+	dkuk::async_core::context_id_type parent_id
+)
+{
+	dkuk::pipeline_stage::parameters parameters;
+	parameters.workers_count  = 0;
+	parameters.queue_capacity = 4;
+	try {
+		dkuk::make_pipeline<int>(core, parent_id).sink([](int && /* value */) {}, parameters);
+	} catch (const std::invalid_argument &) {
+		return true;
+	}
+	return false;
+}
+
+
+// Batches handed off to unbounded stage are counted, until the stage's workers take them.
+bool
+unbounded_stage_counts_queued_batches()
+{
+	dkuk::async_core::context_tree t;
+	const auto root = t.add_context(0, 0);
+	dkuk::async_core core{t, false};
+	
+	std::atomic<std::size_t> received{0};
+	dkuk::pipeline<int> p = dkuk::make_pipeline<int>(core, root).sink([&received](int && /* value */) { ++received; });
+	for (int i = 0; i < 3; ++i)
+		p.push(i);
+	const std::size_t queued_before_start = p.get_stage_statistics(0).batches_queued;
+	
+	core.start();
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+	while (received < 3 && std::chrono::steady_clock::now() < deadline)
+		std::this_thread::sleep_for(std::chrono::milliseconds{1});
+	core.stop();
+	
+	return queued_before_start == 3 && p.get_stage_statistics(0).batches_queued == 0;
+}
+
+
+};	// namespace
+
+
+
+int
+main()
+{
+	dkuk::async_core::context_tree t;
+	const auto root = t.add_context(0, 0);
+	dkuk::async_core core{t, true};
+	
+	dkuk::pipeline_stage::parameters parse_parameters;
+	parse_parameters.workers_count  = 2;
+	parse_parameters.queue_capacity = 4;
+	parse_parameters.batch_size     = batch_size;
+	
+	dkuk::pipeline_stage::parameters filter_parameters;
+	filter_parameters.batch_size = batch_size;
+	filter_parameters.fuse       = true;
+	
+	dkuk::pipeline_stage::parameters sink_parameters;
+	sink_parameters.queue_capacity = 4;
+	
+	std::atomic<std::size_t> sum{0}, received{0};
+	dkuk::pipeline<std::string> p =
+		dkuk::make_pipeline<std::string>(core, root)
+			.stage<std::size_t>(
+				[](std::string &&line, dkuk::pipeline_output<std::size_t> &output) { output(std::stoul(line)); },
+				parse_parameters
+			)
+			.stage<std::size_t>(
+				[](std::size_t &&value, dkuk::pipeline_output<std::size_t> &output)
+				{
+					if (value % 2 == 0)
+						output(value);
+				},
+				filter_parameters
+			)
+			.sink(
+				[&](std::size_t &&value)
+				{
+					sum += value;
+					++received;
+				},
+				sink_parameters
+			);
+	
+	// Producer is blocked, while parse stage's queue is full
+	std::vector<std::string> batch;
+	for (std::size_t i = 0; i < items_count; ++i) {
+		batch.push_back(std::to_string(i));
+		if (batch.size() == batch_size) {
+			p.push_batch(std::move(batch));
+			batch.clear();
+		}
+	}
+	p.push("0");
+	
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+	while (received < items_count / 2 + 1 && std::chrono::steady_clock::now() < deadline)
+		std::this_thread::sleep_for(std::chrono::milliseconds{1});
+	
+	core.stop();
+	
+	int status = 0;
+	
+	const std::size_t expected_sum = (items_count / 2 - 1) * (items_count / 2);	// 0 + 2 + ... + (items_count - 2)
+	if (received != items_count / 2 + 1 || sum != expected_sum) {
+		std::cout << "Error: Received " << received << " items, sum: " << sum << '.' << std::endl;
+		status = 1;
+	}
+	
+	if (!bounded_stage_without_workers_rejected(core, root)) {
+		std::cout << "Error: Bounded stage without workers is accepted." << std::endl;
+		status = 1;
+	}
+	
+	if (!unbounded_stage_counts_queued_batches()) {
+		std::cout << "Error: Queued batches of unbounded stage are not counted." << std::endl;
+		status = 1;
+	}
+	
+	const auto parse_statistics  = p.get_stage_statistics(0);
+	const auto filter_statistics = p.get_stage_statistics(1);
+	const auto sink_statistics   = p.get_stage_statistics(2);
+	if (p.get_stages_count() != 3
+		|| parse_statistics.items_in != items_count + 1 || parse_statistics.items_out != items_count + 1
+		|| parse_statistics.batches_in != items_count / batch_size + 1 || parse_statistics.batches_queued != 0
+		|| !filter_statistics.fused || filter_statistics.context_id != parse_statistics.context_id
+		|| filter_statistics.items_out != items_count / 2 + 1
+		|| sink_statistics.fused || sink_statistics.items_in != items_count / 2 + 1
+		|| sink_statistics.batches_in > items_count / batch_size + 1 || sink_statistics.batches_queued != 0) {
+		std::cout << "Error: Incorrect statistics." << std::endl;
+		status = 1;
+	}
+	
+	return status;
+}
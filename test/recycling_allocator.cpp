@@ -0,0 +1,204 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 09:30
+
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+
+#include <dkuk/coroutine.hpp>
+
+
+// Memory allocated by threads with tracking enabled is counted, so leaked blocks are visible without sanitizers.
+namespace {
+
+
+constexpr std::size_t max_tracked = 256;
+
+
+std::mutex tracked_mutex;
+void *tracked_ptrs[max_tracked] = {};
+std::size_t tracked_count = 0, untracked_count = 0;
+
+
+inline
+bool &
+tracking() noexcept
+{
+	static thread_local bool enabled = false;	// Trivial: may be used during thread exit
+	return enabled;
+}
+
+
+};	// namespace
+
+
+void *
+operator new(
+	std::size_t size
+)
+{
+	void * const ptr = std::malloc((size == 0)? 1: size);
+	if (ptr == nullptr)
+		throw std::bad_alloc{};
+	
+	if (tracking()) {
+		std::lock_guard<std::mutex> lock{tracked_mutex};
+		for (auto &tracked_ptr: tracked_ptrs)
+			if (tracked_ptr == nullptr) {
+				tracked_ptr = ptr;
+				++tracked_count;
+				return ptr;
+			}
+		++untracked_count;
+	}
+	return ptr;
+}
+
+
+void
+operator delete(
+	void *ptr
+) noexcept
+{
+	if (ptr != nullptr) {
+		std::lock_guard<std::mutex> lock{tracked_mutex};
+		for (auto &tracked_ptr: tracked_ptrs)
+			if (tracked_ptr == ptr) {
+				tracked_ptr = nullptr;
+				--tracked_count;
+				break;
+			}
+	}
+	std::free(ptr);
+}
+
+
+void
+operator delete(
+	void *ptr,
+	std::size_t /* size */
+) noexcept
+{
+	::operator delete(ptr);
+}
+
+
+namespace {
+
+
+// Returns number of tracked blocks, which are not freed yet. Lock is released before throwing: operator delete
+// takes it too.
+std::size_t
+leaked_blocks()
+{
+	std::size_t tracked, untracked;
+	{
+		std::lock_guard<std::mutex> lock{tracked_mutex};
+		tracked   = tracked_count;
+		untracked = untracked_count;
+	}
+	
+	if (untracked != 0)
+		throw std::logic_error{"Too many allocations to track"};
+	return tracked;
+}
+
+
+// Promise, which outlives the thread's cache of future states: it is constructed before the cache, so it is
+// destroyed after the cache on thread exit.
+std::unique_ptr<dkuk::coroutine_promise<int>> &
+late_promise_ptr() noexcept
+{
+	static thread_local std::unique_ptr<dkuk::coroutine_promise<int>> promise_ptr;
+	return promise_ptr;
+}
+
+
+// States freed after destruction of the thread's cache are deleted (not cached and leaked), cached states are
+// deleted with the cache.
+void
+check_thread_exit()
+{
+	boost::asio::io_context io_context;
+	
+	std::thread thread{
+		[&io_context]
+		{
+			tracking() = true;
+			auto &promise_ptr = late_promise_ptr();
+			{
+				dkuk::coroutine_promise<int> p1{io_context}, p2{io_context};	// Constructs the cache
+			}
+			promise_ptr.reset(new dkuk::coroutine_promise<int>{io_context});	// Takes a state from the cache
+		}
+	};
+	thread.join();
+	
+	const std::size_t leaked = leaked_blocks();
+	if (leaked != 0)
+		throw std::logic_error{"Thread exit: " + std::to_string(leaked) + " blocks leaked"};
+}
+
+
+// Blocks freed by another thread go to that thread's cache: no block is lost or freed twice.
+void
+check_cross_thread()
+{
+	constexpr std::size_t promises_count = 100;	// Tracked states and vector's buffers fit max_tracked
+	
+	boost::asio::io_context io_context;
+	
+	std::vector<dkuk::coroutine_promise<int>> promises;
+	std::thread producer{
+		[&]
+		{
+			tracking() = true;
+			for (std::size_t i = 0; i < promises_count; ++i)
+				promises.emplace_back(io_context);
+		}
+	};
+	producer.join();
+	
+	std::thread consumer{
+		[&]
+		{
+			tracking() = true;
+			promises.clear();
+			promises.shrink_to_fit();
+		}
+	};
+	consumer.join();
+	
+	const std::size_t leaked = leaked_blocks();
+	if (leaked != 0)
+		throw std::logic_error{"Cross thread: " + std::to_string(leaked) + " blocks leaked"};
+}
+
+
+};	// namespace
+
+
+
+int
+main()
+{
+	int status = 0;
+	
+	try {
+		check_thread_exit();
+		check_cross_thread();
+	} catch (const std::exception &e) {
+		std::cout << "Error: " << e.what() << '.' << std::endl;
+		status = 1;
+	}
+	
+	return status;
+}
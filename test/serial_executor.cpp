@@ -0,0 +1,207 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 07:12
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/io_context_strand.hpp>
+
+#include <dkuk/coroutine.hpp>
+#include <dkuk/serial_executor.hpp>
+
+
+namespace {
+
+
+constexpr std::size_t threads_count = 4;
+constexpr std::size_t producers_count = 4;
+constexpr std::size_t handlers_count = 10000;	// Per producer
+
+
+void
+run_threads(
+	boost::asio::io_context &io_context,
+	std::size_t count
+)
+{
+	std::vector<std::thread> threads;
+	for (std::size_t i = 0; i < count; ++i)
+		threads.emplace_back([&io_context] { io_context.run(); });
+	for (auto &thread: threads)
+		thread.join();
+}
+
+
+// Handlers posted from several threads are executed one at a time, in order of each producer.
+void
+check_serialization()
+{
+	boost::asio::io_context io_context;
+	auto work_guard = boost::asio::make_work_guard(io_context);
+	dkuk::serial_executor executor{io_context};
+	
+	std::atomic<bool> inside{false}, overlapped{false}, reordered{false};
+	std::vector<std::size_t> last_values(producers_count, 0);	// Accessed by the executor only
+	std::atomic<std::size_t> executed{0};
+	
+	std::vector<std::thread> producers;
+	for (std::size_t p = 0; p < producers_count; ++p)
+		producers.emplace_back(
+			[&, p]
+			{
+				for (std::size_t i = 1; i <= handlers_count; ++i)
+					executor.post(
+						[&, p, i]
+						{
+							if (inside.exchange(true))
+								overlapped = true;
+							if (!executor.running_in_this_thread())
+								overlapped = true;
+							if (last_values[p] + 1 != i)
+								reordered = true;
+							last_values[p] = i;
+							inside = false;
+							
+							if (++executed == producers_count * handlers_count)
+								work_guard.reset();
+						}
+					);
+			}
+		);
+	
+	run_threads(io_context, threads_count);
+	for (auto &producer: producers)
+		producer.join();
+	
+	if (overlapped)
+		throw std::logic_error{"Handlers of serial executor overlapped"};
+	if (reordered)
+		throw std::logic_error{"Handlers of serial executor reordered"};
+	if (executed != producers_count * handlers_count)
+		throw std::logic_error{"Handlers executed: " + std::to_string(executed.load())};
+}
+
+
+// Coroutines spawned with io_context get distinct executors, so they run in parallel (one waits for another).
+void
+check_no_aliasing()
+{
+	constexpr std::size_t coroutines_count = 256;	// More than io_context::strand implementations
+	
+	boost::asio::io_context io_context;
+	std::atomic<std::size_t> started{0};
+	std::atomic<bool> timed_out{false};
+	
+	for (std::size_t i = 0; i < coroutines_count; ++i)
+		dkuk::spawn(
+			io_context,
+			[&](dkuk::coroutine_context)
+			{
+				// Each pair of coroutines waits for each other
+				const std::size_t pair_started = ++started;
+				const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+				while (started < pair_started + pair_started % 2 && !timed_out)
+					if (std::chrono::steady_clock::now() > deadline)
+						timed_out = true;
+			}
+		);
+	
+	run_threads(io_context, 2);
+	
+	if (timed_out)
+		throw std::logic_error{"Unrelated coroutines are serialized"};
+}
+
+
+// Exception goes to io_context's runner, executor continues after that.
+void
+check_exception()
+{
+	boost::asio::io_context io_context;
+	dkuk::serial_executor executor{io_context};
+	
+	bool dispatched_inline = false, executed_after = false;
+	executor.post(
+		[&]
+		{
+			executor.dispatch([&] { dispatched_inline = true; });
+			if (!dispatched_inline)
+				throw std::logic_error{"Handler is not dispatched inline"};
+			throw std::runtime_error{"Expected"};
+		}
+	);
+	executor.post([&] { executed_after = true; });
+	
+	try {
+		io_context.run();
+		throw std::logic_error{"Exception is not rethrown from io_context"};
+	} catch (const std::runtime_error &e) {
+		if (std::string{e.what()} != "Expected")
+			throw;
+	}
+	
+	io_context.restart();
+	io_context.run();
+	if (!executed_after)
+		throw std::logic_error{"Executor stopped after exception"};
+	if (executor.running_in_this_thread())
+		throw std::logic_error{"Executor is running outside of its handlers"};
+}
+
+
+// Coroutine spawned with strand gives access to it (get_executor() returned the strand itself before).
+void
+check_strand()
+{
+	boost::asio::io_context io_context;
+	boost::asio::io_context::strand strand{io_context};
+	
+	bool strand_coroutine_checked = false, io_context_coroutine_checked = false;
+	dkuk::spawn(
+		strand,
+		[&](dkuk::coroutine_context context)
+		{
+			const auto &coroutine_strand = context.get_executor().get_strand();
+			strand_coroutine_checked = coroutine_strand && coroutine_strand->running_in_this_thread();
+		}
+	);
+	dkuk::spawn(
+		io_context,
+		[&](dkuk::coroutine_context context)
+		{
+			io_context_coroutine_checked = !context.get_executor().get_strand();
+		}
+	);
+	io_context.run();
+	
+	if (!strand_coroutine_checked || !io_context_coroutine_checked)
+		throw std::logic_error{"Strand of coroutine's executor is incorrect"};
+}
+
+
+};	// namespace
+
+
+
+int
+main()
+{
+	int status = 0;
+	try {
+		check_serialization();
+		check_no_aliasing();
+		check_exception();
+		check_strand();
+	} catch (const std::exception &e) {
+		std::cout << "Error: " << e.what() << '.' << std::endl;
+		status = 1;
+	}
+	
+	return status;
+}
@@ -0,0 +1,186 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 06:18
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <initializer_list>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#	include <sched.h>
+#endif	// __linux__
+
+#include <dkuk/shard_core.hpp>
+
+
+namespace {
+
+
+constexpr std::size_t shards_count = 4;
+
+
+dkuk::shard_core::parameters
+test_parameters(
+	std::size_t ring_capacity
+)
+{
+	dkuk::shard_core::parameters parameters;
+	parameters.shards_count  = shards_count;
+	parameters.pin_workers   = false;	// Test may be run with less CPUs available
+	parameters.ring_capacity = ring_capacity;
+	parameters.worker_parameters.delay_policy = dkuk::async_core::worker::delay::yield;
+	return parameters;
+}
+
+
+// Functions submitted from outside are executed on the target shards.
+void
+check_submit()
+{
+	dkuk::shard_core core{test_parameters(1024)};
+	
+	std::vector<dkuk::coroutine_future<std::size_t>> futures;
+	for (std::size_t i = 0; i < shards_count; ++i)
+		futures.push_back(core.submit_to(i, [&core] { return core.get_current_shard().get(); }));
+	
+	for (std::size_t i = 0; i < shards_count; ++i) {
+		const std::size_t shard = futures[i].get();
+		if (shard != i)
+			throw std::logic_error{"Submit: function executed on shard " + std::to_string(shard)};
+	}
+	
+	if (core.get_current_shard())
+		throw std::logic_error{"Submit: main thread is a shard"};
+	
+	auto exception_future = core.submit_to(0, []() -> int { throw std::runtime_error{"As expected"}; });
+	bool thrown = false;
+	try {
+		exception_future.get();
+	} catch (const std::runtime_error &) {
+		thrown = true;
+	}
+	if (!thrown)
+		throw std::logic_error{"Submit: exception is not passed through the future"};
+}
+
+
+// Each shard sends messages to all others through rings; small ring capacity forces fallback too.
+void
+check_cross_shard(
+	std::size_t ring_capacity
+)
+{
+	constexpr std::size_t messages_count = 1000;
+	
+	dkuk::shard_core core{test_parameters(ring_capacity)};
+	
+	std::atomic<std::size_t> received[shards_count] = {};
+	std::vector<dkuk::coroutine_future<void>> futures;
+	for (std::size_t from = 0; from < shards_count; ++from)
+		futures.push_back(
+			core.submit_to(
+				from,
+				[&core, &received, from]
+				{
+					for (std::size_t i = 0; i < messages_count; ++i)
+						for (std::size_t to = 0; to < shards_count; ++to)
+							if (to != from)
+								core.submit_to(to, [&received, to] { ++received[to]; });
+				}
+			)
+		);
+	
+	for (auto &future: futures)
+		future.get();
+	
+	const std::size_t expected = messages_count * (shards_count - 1);
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+	for (std::size_t to = 0; to < shards_count; ++to) {
+		while (received[to] < expected && std::chrono::steady_clock::now() < deadline)
+			std::this_thread::sleep_for(std::chrono::milliseconds{1});
+		
+		if (received[to] != expected)
+			throw std::logic_error{
+				"Cross shard (ring capacity: " + std::to_string(ring_capacity) + "): shard " + std::to_string(to)
+				+ " received " + std::to_string(received[to].load()) + " of " + std::to_string(expected)
+			};
+	}
+}
+
+
+// Messages not executed before stop() break their promises instead of hanging forever.
+void
+check_stop()
+{
+	dkuk::shard_core core{test_parameters(1024), false};
+	
+	auto future = core.submit_to(1, [] { return 42; });
+	core.stop();
+	
+	bool broken = false;
+	try {
+		future.get();
+	} catch (const std::future_error &e) {
+		broken = e.code() == std::future_errc::broken_promise;
+	}
+	if (!broken)
+		throw std::logic_error{"Stop: promise of not executed message is not broken"};
+	
+	core.start();
+	if (core.submit_to(1, [] { return 42; }).get() != 42)
+		throw std::logic_error{"Stop: core doesn't work after restart"};
+}
+
+
+#ifdef __linux__
+// Workers are pinned to CPUs allowed for the process only (e.g. by taskset), even if shards are more than CPUs.
+void
+check_pinning()
+{
+	cpu_set_t allowed_cpu_set;
+	CPU_ZERO(&allowed_cpu_set);
+	if (sched_getaffinity(0, sizeof(allowed_cpu_set), &allowed_cpu_set) != 0)
+		throw std::logic_error{"Pinning: sched_getaffinity() failed"};
+	
+	auto parameters = test_parameters(1024);
+	parameters.pin_workers  = true;
+	parameters.shards_count = 2 * static_cast<std::size_t>(CPU_COUNT(&allowed_cpu_set));
+	dkuk::shard_core core{parameters};
+	
+	for (std::size_t i = 0; i < parameters.shards_count; ++i) {
+		const int cpu = core.submit_to(i, [] { return sched_getcpu(); }).get();
+		if (cpu < 0 || !CPU_ISSET(cpu, &allowed_cpu_set))
+			throw std::logic_error{"Pinning: shard " + std::to_string(i) + " runs on CPU " + std::to_string(cpu)};
+	}
+}
+#endif	// __linux__
+
+
+};	// namespace
+
+
+
+int
+main()
+{
+	int status = 0;
+	
+	try {
+		check_submit();
+		for (const std::size_t ring_capacity: {1, 1024})
+			check_cross_shard(ring_capacity);
+		check_stop();
+#ifdef __linux__
+		check_pinning();
+#endif	// __linux__
+	} catch (const std::exception &e) {
+		std::cout << "Error: " << e.what() << '.' << std::endl;
+		status = 1;
+	}
+	
+	return status;
+}
@@ -0,0 +1,134 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 06:53
+
+#include <future>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+
+#include <dkuk/coroutine.hpp>
+
+
+namespace {
+
+
+// Counts copies of the payload.
+struct payload
+{
+	payload() = default;
+	
+	
+	payload(
+		const payload &other
+	):
+		data{other.data}
+	{
+		++copies;
+	}
+	
+	
+	payload(
+		payload &&other
+	) = default;
+	
+	
+	payload &
+	operator=(
+		const payload &other
+	) = delete;
+	
+	
+	
+	static std::size_t copies;
+	
+	std::vector<char> data = std::vector<char>(1 << 20, 'x');
+};	// struct payload
+
+
+std::size_t payload::copies = 0;
+
+
+payload
+make_payload(
+	dkuk::coroutine_context /* context */
+)
+{
+	return payload{};
+}
+
+
+std::unique_ptr<int>
+make_unique_int(
+	dkuk::coroutine_context /* context */
+)
+{
+	return std::unique_ptr<int>{new int{42}};
+}
+
+
+};	// namespace
+
+
+
+int
+main()
+{
+	boost::asio::io_context io_context;
+	int status = 0;
+	
+	// Unique future: value is moved out, so move-only types are supported
+	auto unique_future = dkuk::run_until_complete(io_context, dkuk::spawn_with_future(io_context, make_unique_int));
+	const std::unique_ptr<int> int_ptr = unique_future.get();
+	if (int_ptr == nullptr || *int_ptr != 42 || unique_future.valid()) {
+		std::cout << "Error: Incorrect unique future result." << std::endl;
+		status = 1;
+	}
+	
+	// Shared future: several consumers, no copies
+	io_context.restart();
+	const auto shared_future =
+		dkuk::run_until_complete(io_context, dkuk::spawn_with_future(io_context, make_payload).share());
+	const auto shared_future_copy = shared_future;
+	const payload &payload_1 = shared_future.get();
+	const payload &payload_2 = shared_future_copy.get();
+	if (&payload_1 != &payload_2 || payload_1.data.size() != (1 << 20) || payload::copies != 0) {
+		std::cout << "Error: Shared future result is copied " << payload::copies << " times." << std::endl;
+		status = 1;
+	}
+	
+	// Consumers in coroutines
+	io_context.restart();
+	std::size_t consumed = 0;
+	dkuk::coroutine_promise<payload> promise{io_context};
+	const auto future = promise.get_future().share();
+	for (int i = 0; i < 3; ++i)
+		dkuk::spawn(
+			io_context,
+			[&consumed, future](dkuk::coroutine_context context)
+			{
+				if (future.get(context).data.size() == (1 << 20))
+					++consumed;
+			}
+		);
+	dkuk::spawn(io_context, [&promise](dkuk::coroutine_context) { promise.set_value(payload{}); });
+	io_context.run();
+	if (consumed != 3 || payload::copies != 0) {
+		std::cout << "Error: Consumed " << consumed << " results, " << payload::copies << " copies." << std::endl;
+		status = 1;
+	}
+	
+	bool thrown = false;
+	try {
+		promise.get_future();
+	} catch (const std::future_error &) {
+		thrown = true;
+	}
+	if (!thrown) {
+		std::cout << "Error: Future is retrieved twice." << std::endl;
+		status = 1;
+	}
+	
+	return status;
+}
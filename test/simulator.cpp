@@ -0,0 +1,165 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 08:21
+
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include <dkuk/async_core.hpp>
+#include <dkuk/async_core_simulator.hpp>
+
+
+namespace {
+
+
+using cost = dkuk::async_core_simulator::handler_cost;
+
+
+// Root worker polls root and two children, which get tasks with different costs.
+struct model
+{
+	explicit
+	model(
+		const dkuk::async_core::worker::parameters &parameters,
+		std::uint64_t seed = 1
+	):
+		simulator{make_tree(parameters), make_simulator_parameters(seed)}
+	{
+		this->simulator.add_workload(1, 2000, cost::exponential(std::chrono::microseconds{100}));
+		this->simulator.add_workload(2, 100, cost::uniform(std::chrono::milliseconds{1}, std::chrono::milliseconds{5}));
+		this->simulator.run_for(std::chrono::seconds{10});
+	}
+	
+	
+	static
+	dkuk::async_core::context_tree
+	make_tree(
+		const dkuk::async_core::worker::parameters &parameters
+	)
+	{
+		dkuk::async_core::context_tree t;
+		const auto root = t.add_context(0, 0);
+		t.add_context(root, 0);
+		t.add_context(root, 0);
+		t.add_worker(root, parameters);
+		t.add_worker(root, parameters);
+		return t;
+	}
+	
+	
+	static
+	dkuk::async_core_simulator::parameters
+	make_simulator_parameters(
+		std::uint64_t seed
+	)
+	{
+		dkuk::async_core_simulator::parameters parameters;
+		parameters.seed = seed;
+		return parameters;
+	}
+	
+	
+	
+	dkuk::async_core_simulator simulator;
+};	// struct model
+
+
+
+// Same seed gives the same results, another one differs.
+void
+check_determinism()
+{
+	const dkuk::async_core::worker::parameters parameters;
+	const model m1{parameters}, m2{parameters}, m3{parameters, 2};
+	
+	const auto s1 = m1.simulator.get_context_statistics(1), s2 = m2.simulator.get_context_statistics(1);
+	const auto s3 = m3.simulator.get_context_statistics(1);
+	if (
+		s1.tasks_executed != s2.tasks_executed || s1.mean_latency != s2.mean_latency
+		|| s1.max_latency != s2.max_latency
+		|| m1.simulator.get_worker_statistics(0, 1).rounds != m2.simulator.get_worker_statistics(0, 1).rounds
+	)
+		throw std::logic_error{"Simulation is not deterministic"};
+	if (s1.tasks_executed == s3.tasks_executed && s1.mean_latency == s3.mean_latency)
+		throw std::logic_error{"Seed is ignored"};
+	
+	// Underloaded workers execute all tasks: ~20000 + ~1000 in 10 seconds
+	const auto s = m1.simulator.get_context_statistics(2);
+	if (s1.tasks_executed < 19000 || s1.tasks_executed > 21000 || s.tasks_executed < 900 || s.tasks_executed > 1100)
+		throw std::logic_error{"Incorrect tasks count: " + std::to_string(s1.tasks_executed)};
+	if (s1.tasks_posted - s1.tasks_executed > 2 || s1.tasks_queued > 2)
+		throw std::logic_error{"Tasks are not executed"};
+}
+
+
+// Spinning workers (no_delay) burn CPU, but have lower latency than sleeping ones.
+void
+check_delay_policies()
+{
+	dkuk::async_core::worker::parameters spin_parameters, sleep_parameters;
+	spin_parameters.delay_policy  = dkuk::async_core::worker::delay::no_delay;
+	sleep_parameters.delay_policy = dkuk::async_core::worker::delay::sleep;
+	sleep_parameters.delay_value  = std::chrono::milliseconds{1};
+	
+	const model spin{spin_parameters}, sleep{sleep_parameters};
+	
+	const auto spin_worker = spin.simulator.get_worker_statistics(0, 0);
+	const auto sleep_worker = sleep.simulator.get_worker_statistics(0, 0);
+	if (
+		spin_worker.overhead_time <= sleep_worker.overhead_time
+		|| sleep_worker.delay_time == std::chrono::nanoseconds::zero()
+	)
+		throw std::logic_error{"Sleeping workers don't save CPU"};
+	if (spin_worker.idle_rounds == 0 || spin_worker.idle_rounds >= spin_worker.rounds)
+		throw std::logic_error{"Incorrect rounds statistics"};
+	
+	if (
+		spin.simulator.get_context_statistics(1).mean_latency
+		>= sleep.simulator.get_context_statistics(1).mean_latency
+	)
+		throw std::logic_error{"Sleeping workers have lower latency"};
+}
+
+
+// Worker of single context blocks in run_one() without CPU usage; disabled contexts are not run.
+void
+check_single_context()
+{
+	dkuk::async_core::context_tree t;
+	const auto root = t.add_context(0, 1);
+	const auto disabled = t.add_context(root, 0, false);
+	
+	dkuk::async_core_simulator s{t};
+	s.schedule(std::chrono::seconds{1}, [&s, root] { s.post(root, std::chrono::milliseconds{10}); });
+	s.schedule(std::chrono::seconds{1}, [&s, disabled] { s.post(disabled, std::chrono::milliseconds{10}); });
+	s.run_for(std::chrono::seconds{2});
+	
+	const auto worker = s.get_worker_statistics(root, 0);
+	if (worker.handlers_executed != 1 || worker.overhead_time != std::chrono::nanoseconds::zero())
+		throw std::logic_error{"Worker of single context polls it"};
+	if (worker.blocked_time + worker.busy_time != s.now())
+		throw std::logic_error{"Incorrect worker time"};
+	if (s.get_context_statistics(disabled).tasks_executed != 0)
+		throw std::logic_error{"Disabled context is run"};
+}
+
+
+};	// namespace
+
+
+
+int
+main()
+{
+	int status = 0;
+	try {
+		check_determinism();
+		check_delay_policies();
+		check_single_context();
+	} catch (const std::exception &e) {
+		std::cout << "Error: " << e.what() << '.' << std::endl;
+		status = 1;
+	}
+	
+	return status;
+}
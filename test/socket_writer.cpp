@@ -0,0 +1,140 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 07:22
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio/bind_executor.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/read.hpp>
+
+#include <dkuk/coroutine.hpp>
+#include <dkuk/socket_writer.hpp>
+
+
+namespace {
+
+
+constexpr std::size_t writers_count = 100;
+constexpr std::size_t message_size = 16;
+
+
+// Handler runs in its associated executor, and that executor's io_context doesn't run out of work, while the
+// message is queued.
+void
+check_associated_executor()
+{
+	boost::asio::io_context io_context, handler_io_context;
+	boost::asio::local::stream_protocol::socket s1{io_context}, s2{io_context};
+	boost::asio::local::connect_pair(s1, s2);
+	
+	dkuk::socket_writer<boost::asio::local::stream_protocol::socket> writer{s1};
+	
+	const std::string message(message_size, 'A');
+	bool handler_called = false, handler_in_executor = false;
+	writer.async_write(
+		boost::asio::buffer(message),
+		boost::asio::bind_executor(
+			handler_io_context,
+			[&](const boost::system::error_code &ec, std::size_t bytes_transferred)
+			{
+				handler_called = !ec && bytes_transferred == message_size;
+				handler_in_executor = handler_io_context.get_executor().running_in_this_thread();
+			}
+		)
+	);
+	
+	std::thread handler_thread{[&handler_io_context] { handler_io_context.run(); }};	// Doesn't return at once
+	
+	std::string received(message_size, '\0');
+	boost::asio::async_read(
+		s2,
+		boost::asio::buffer(&received[0], received.size()),
+		[](const boost::system::error_code & /* ec */, std::size_t /* bytes_transferred */) {}
+	);
+	io_context.run();
+	handler_thread.join();
+	
+	if (!handler_called)
+		throw std::logic_error{"Handler is not called"};
+	if (!handler_in_executor)
+		throw std::logic_error{"Handler is not called in its associated executor"};
+}
+
+
+};	// namespace
+
+
+
+int
+main()
+{
+	boost::asio::io_context io_context;
+	boost::asio::local::stream_protocol::socket s1{io_context}, s2{io_context};
+	boost::asio::local::connect_pair(s1, s2);
+	
+	dkuk::socket_writer<boost::asio::local::stream_protocol::socket> writer{s1};
+	
+	// Each coroutine sends message of its own letter, split into two buffers
+	std::vector<std::string> messages;
+	for (std::size_t i = 0; i < writers_count; ++i)
+		messages.emplace_back(message_size, static_cast<char>('A' + i % 26));
+	
+	std::size_t completed = 0;
+	for (std::size_t i = 0; i < writers_count; ++i)
+		dkuk::spawn(
+			io_context,
+			[&, i](dkuk::coroutine_context context)
+			{
+				const std::string &message = messages[i];
+				const std::vector<boost::asio::const_buffer> buffers{
+					boost::asio::buffer(message.data(), message_size / 2),
+					boost::asio::buffer(message.data() + message_size / 2, message_size / 2)
+				};
+				if (writer.async_write(buffers, context) == message_size)
+					++completed;
+			}
+		);
+	
+	std::string received(writers_count * message_size, '\0');
+	dkuk::spawn(
+		io_context,
+		[&](dkuk::coroutine_context context)
+		{
+			boost::asio::async_read(s2, boost::asio::buffer(&received[0], received.size()), context);
+		}
+	);
+	
+	int status = 0;
+	try {
+		check_associated_executor();
+		
+		io_context.run();
+		
+		if (completed != writers_count)
+			throw std::logic_error{"Writers completed: " + std::to_string(completed)};
+		
+		// Messages are not interleaved
+		for (std::size_t i = 0; i < writers_count; ++i) {
+			const std::string message = received.substr(i * message_size, message_size);
+			if (message.find_first_not_of(message[0]) != std::string::npos)
+				throw std::logic_error{"Messages interleaved: " + message};
+		}
+		
+		const auto statistics = writer.get_statistics();
+		if (statistics.messages_count != writers_count)
+			throw std::logic_error{"Messages: " + std::to_string(statistics.messages_count)};
+		if (statistics.flushes_count >= writers_count / 2)
+			throw std::logic_error{"Writes are not coalesced, flushes: " + std::to_string(statistics.flushes_count)};
+	} catch (const std::exception &e) {
+		std::cout << "Error: " << e.what() << '.' << std::endl;
+		status = 1;
+	}
+	
+	return status;
+}
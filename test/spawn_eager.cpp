@@ -0,0 +1,91 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 06:24
+
+#include <iostream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/optional.hpp>
+
+#include <dkuk/coroutine.hpp>
+
+
+namespace {
+
+
+constexpr std::size_t nested_count = 100;	// More than eager depth limit
+
+
+// Each coroutine spawns the next one eagerly.
+void
+spawn_nested(
+	std::size_t depth,
+	std::size_t &finished,
+	dkuk::coroutine_context context
+)
+{
+	if (depth < nested_count)
+		dkuk::spawn_eager(context, spawn_nested, depth + 1, std::ref(finished));
+	++finished;
+}
+
+
+};	// namespace
+
+
+
+int
+main()
+{
+	boost::asio::io_context io_context;
+	boost::asio::io_context::strand strand{io_context};
+	
+	bool eager_started = false, lazy_started = false, resumed_inline = false;
+	std::size_t nested_finished = 0;
+	
+	dkuk::spawn(
+		strand,
+		[&](dkuk::coroutine_context context)
+		{
+			// Same strand: eager coroutine runs before spawn_eager() returns, plain one doesn't
+			dkuk::spawn_eager(context, [&](dkuk::coroutine_context) { eager_started = true; });
+			dkuk::spawn(strand, [&](dkuk::coroutine_context) { lazy_started = true; });
+			if (!eager_started || lazy_started)
+				throw std::logic_error{"Eager coroutine is not started inline"};
+			
+			// Eager coroutine is resumed inline by caller
+			boost::optional<dkuk::coroutine_context::caller<>> resume;
+			bool resumed = false;
+			dkuk::spawn_eager(
+				context,
+				[&](dkuk::coroutine_context child_context)
+				{
+					dkuk::coroutine_context::value<> value{child_context};
+					resume.emplace(child_context.get_caller(value));
+					value.get();
+					resumed = true;
+				}
+			);
+			(*resume)();
+			resumed_inline = resumed;
+			
+			dkuk::spawn_eager(context, spawn_nested, 1, std::ref(nested_finished));
+		}
+	);
+	
+	int status = 0;
+	try {
+		io_context.run();
+		
+		if (!resumed_inline)
+			throw std::logic_error{"Eager coroutine is not resumed inline"};
+		if (nested_finished != nested_count)
+			throw std::logic_error{"Nested eager coroutines finished: " + std::to_string(nested_finished)};
+	} catch (const std::exception &e) {
+		std::cout << "Error: " << e.what() << '.' << std::endl;
+		status = 1;
+	}
+	
+	return status;
+}
@@ -0,0 +1,179 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 06:21
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <initializer_list>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/system_timer.hpp>
+
+#include <dkuk/async_core.hpp>
+#include <dkuk/coroutine.hpp>
+
+
+namespace {
+
+
+// Returns id of the thread, which runs the context (context has one worker).
+std::thread::id
+get_worker_id(
+	boost::asio::io_context &io_context
+)
+{
+	std::promise<std::thread::id> worker_id_promise;
+	std::future<std::thread::id> worker_id_future = worker_id_promise.get_future();
+	boost::asio::post(io_context, [&worker_id_promise] { worker_id_promise.set_value(std::this_thread::get_id()); });
+	return worker_id_future.get();
+}
+
+
+void
+check_thread(
+	std::thread::id expected,
+	const char *where
+)
+{
+	if (std::this_thread::get_id() != expected)
+		throw std::logic_error{where};
+}
+
+
+// Coroutine is migrated to another context and back, and its async operations complete in the current context.
+void
+check_migration()
+{
+	dkuk::async_core::context_tree t;
+	const auto root        = t.add_context(0, 0);
+	const auto lightweight = t.add_context(root, 1);
+	const auto heavyweight = t.add_context(root, 1);
+	
+	dkuk::async_core core{t};
+	const std::thread::id lightweight_id = get_worker_id(core.get_io_context(lightweight));
+	const std::thread::id heavyweight_id = get_worker_id(core.get_io_context(heavyweight));
+	
+	auto result_future = dkuk::spawn_with_future(
+		core.get_io_context(lightweight),
+		[&](dkuk::coroutine_context context) -> int
+		{
+			check_thread(lightweight_id, "Coroutine is not started in lightweight context");
+			
+			context.switch_to(core, heavyweight);
+			check_thread(heavyweight_id, "Coroutine is not migrated to heavyweight context");
+			if (!context.get_executor().running_in_this_thread())
+				throw std::logic_error{"Coroutine is not bound to the new strand"};
+			
+			// Async operations complete in the new context
+			boost::asio::system_timer timer{context.get_executor().context(), std::chrono::milliseconds{10}};
+			timer.async_wait(context);
+			check_thread(heavyweight_id, "Async operation is not completed in heavyweight context");
+			
+			context.switch_to(core.get_io_context(lightweight));
+			check_thread(lightweight_id, "Coroutine is not migrated back to lightweight context");
+			return 42;
+		}
+	);
+	
+	if (result_future.get() != 42)
+		throw std::logic_error{"Migration: wrong result"};
+}
+
+
+// Exception thrown after migration is delivered once, to the new context's worker.
+void
+check_exception_after_switch()
+{
+	dkuk::async_core::context_tree t;
+	const auto root        = t.add_context(0, 0);
+	const auto lightweight = t.add_context(root, 1);
+	const auto heavyweight = t.add_context(root, 1);
+	
+	std::atomic<std::size_t> exceptions{0};
+	dkuk::async_core core{t, [&exceptions](const std::exception &) { ++exceptions; }};
+	const std::thread::id heavyweight_id = get_worker_id(core.get_io_context(heavyweight));
+	
+	std::atomic<bool> switched{false};
+	dkuk::spawn(
+		core.get_io_context(lightweight),
+		[&](dkuk::coroutine_context context)
+		{
+			context.switch_to(core, heavyweight);
+			switched = (std::this_thread::get_id() == heavyweight_id);
+			throw std::runtime_error{"Coroutine failed"};
+		}
+	);
+	
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+	while (exceptions == 0 && std::chrono::steady_clock::now() < deadline)
+		std::this_thread::sleep_for(std::chrono::milliseconds{1});
+	std::this_thread::sleep_for(std::chrono::milliseconds{50});	// Second delivery, if any, happens by now
+	core.stop();
+	
+	if (!switched || exceptions != 1)
+		throw std::logic_error{"Exception after switch: delivered " + std::to_string(exceptions.load()) + " times"};
+}
+
+
+// Eager coroutine switched to the executor, which is already running, is resumed inline. Its exception is still
+// delivered once.
+void
+check_exception_after_eager_switch()
+{
+	boost::asio::io_context io_context;
+	dkuk::serial_executor executor{io_context};
+	
+	dkuk::spawn(
+		executor,
+		[](dkuk::coroutine_context context)
+		{
+			dkuk::spawn_eager(
+				context,
+				[](dkuk::coroutine_context context)
+				{
+					context.switch_to(context.get_executor());
+					throw std::runtime_error{"Coroutine failed"};
+				}
+			);
+		}
+	);
+	
+	std::size_t exceptions = 0;
+	while (true) {
+		try {
+			io_context.run();
+			break;
+		} catch (const std::runtime_error &) {
+			++exceptions;
+		}
+	}
+	
+	if (exceptions != 1)
+		throw std::logic_error{"Exception after eager switch: delivered " + std::to_string(exceptions) + " times"};
+}
+
+
+};	// namespace
+
+
+
+int
+main()
+{
+	int status = 0;
+	
+	for (const auto &check: {check_migration, check_exception_after_switch, check_exception_after_eager_switch}) {
+		try {
+			check();
+		} catch (const std::exception &e) {
+			std::cout << "Error: " << e.what() << '.' << std::endl;
+			status = 1;
+		}
+	}
+	
+	return status;
+}
@@ -0,0 +1,300 @@
+// Author: Dmitry Kukovinets (d1021976@gmail.com), 17.10.2026, 06:15
+
+#include <atomic>
+#include <chrono>
+#include <initializer_list>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dkuk/async_core.hpp>
+
+
+namespace {
+
+
+constexpr std::size_t capacity = 10, tasks_count = 15;
+
+
+void
+wait_executed(
+	const std::atomic<std::size_t> &executed,
+	std::size_t expected,
+	const std::string &what
+)
+{
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+	while (executed < expected && std::chrono::steady_clock::now() < deadline)
+		std::this_thread::sleep_for(std::chrono::milliseconds{1});
+	
+	if (executed != expected)
+		throw std::logic_error{
+			what + ": executed " + std::to_string(executed.load()) + " of " + std::to_string(expected)
+		};
+}
+
+
+dkuk::async_core::context::parameters
+bounded_parameters(
+	dkuk::async_core::context::overflow overflow_policy
+)
+{
+	dkuk::async_core::context::parameters parameters;
+	parameters.capacity        = capacity;
+	parameters.overflow_policy = overflow_policy;
+	return parameters;
+}
+
+
+// Tasks are posted before start, so the queue overflows.
+void
+check_reject()
+{
+	dkuk::async_core::context_tree t;
+	const auto root = t.add_context(0, 1, bounded_parameters(dkuk::async_core::context::overflow::reject));
+	dkuk::async_core core{t, false};
+	
+	std::atomic<std::size_t> executed{0};
+	std::size_t accepted = 0;
+	for (std::size_t i = 0; i < tasks_count; ++i)
+		if (core.try_post(root, [&executed] { ++executed; }))
+			++accepted;
+	
+	bool thrown = false;
+	try {
+		core.post(root, [&executed] { ++executed; });
+	} catch (const dkuk::context_overflow &) {
+		thrown = true;
+	}
+	
+	const auto statistics = core.get_context_statistics(root);
+	if (accepted != capacity || !thrown || statistics.tasks_rejected != tasks_count - capacity + 1)
+		throw std::logic_error{"Reject: accepted " + std::to_string(accepted) + " tasks"};
+	
+	core.start();
+	wait_executed(executed, capacity, "Reject");
+	core.stop();
+}
+
+
+// Only the newest tasks are executed. Move-only handlers are supported.
+void
+check_drop_oldest()
+{
+	dkuk::async_core::context_tree t;
+	const auto root = t.add_context(0, 1, bounded_parameters(dkuk::async_core::context::overflow::drop_oldest));
+	dkuk::async_core core{t, false};
+	
+	std::atomic<std::size_t> executed{0};
+	std::mutex values_mutex;
+	std::vector<std::size_t> values;
+	for (std::size_t i = 0; i < tasks_count; ++i) {
+		std::unique_ptr<std::size_t> value_ptr{new std::size_t{i}};
+		core.post(
+			root,
+			[&, value_ptr = std::move(value_ptr)]
+			{
+				{
+					std::lock_guard<std::mutex> values_lock{values_mutex};
+					values.push_back(*value_ptr);
+				}
+				++executed;
+			}
+		);
+	}
+	
+	const auto statistics = core.get_context_statistics(root);
+	if (statistics.tasks_dropped != tasks_count - capacity || statistics.queue_size != capacity)
+		throw std::logic_error{"Drop oldest: dropped " + std::to_string(statistics.tasks_dropped) + " tasks"};
+	
+	core.start();
+	wait_executed(executed, capacity, "Drop oldest");
+	core.stop();
+	
+	for (std::size_t i = 0; i < values.size(); ++i)
+		if (values[i] != tasks_count - capacity + i)
+			throw std::logic_error{"Drop oldest: unexpected task executed: " + std::to_string(values[i])};
+}
+
+
+// Overflowed tasks go to the sibling context.
+void
+check_redirect()
+{
+	auto parameters = bounded_parameters(dkuk::async_core::context::overflow::redirect);
+	
+	dkuk::async_core::context_tree t;
+	const auto root      = t.add_context(0, 0);
+	const auto primary   = t.add_context(root, 1);
+	const auto secondary = t.add_context(root, 1);
+	parameters.overflow_context_id = secondary;
+	t.set_context_parameters(primary, parameters);
+	dkuk::async_core core{t, false};
+	
+	std::atomic<std::size_t> executed{0};
+	for (std::size_t i = 0; i < tasks_count; ++i)
+		core.post(primary, [&executed] { ++executed; });
+	
+	if (core.get_context_statistics(primary).tasks_redirected != tasks_count - capacity)
+		throw std::logic_error{"Redirect: tasks are not redirected"};
+	
+	core.start();
+	wait_executed(executed, tasks_count, "Redirect");
+	core.stop();
+}
+
+
+// Poster is blocked until workers free the queue.
+void
+check_block()
+{
+	dkuk::async_core::context_tree t;
+	const auto root = t.add_context(0, 1, bounded_parameters(dkuk::async_core::context::overflow::block));
+	dkuk::async_core core{t, false};
+	
+	std::atomic<std::size_t> executed{0};
+	for (std::size_t i = 0; i < capacity; ++i)
+		core.post(root, [&executed] { ++executed; });
+	
+	if (core.try_post(root, [&executed] { ++executed; }))
+		throw std::logic_error{"Block: try_post() accepted task to the full queue"};
+	
+	std::atomic<bool> posted{false};
+	std::thread poster{
+		[&]
+		{
+			for (std::size_t i = capacity; i < tasks_count; ++i)
+				core.post(root, [&executed] { ++executed; });
+			posted = true;
+		}
+	};
+	
+	std::this_thread::sleep_for(std::chrono::milliseconds{50});
+	const bool blocked = !posted;
+	
+	core.start();
+	poster.join();
+	wait_executed(executed, tasks_count, "Block");
+	core.stop();
+	
+	if (!blocked)
+		throw std::logic_error{"Block: poster is not blocked"};
+}
+
+
+// Retired contexts don't accept tasks: their io_contexts are stopped, so tasks would be lost silently.
+void
+check_retired()
+{
+	auto parameters = bounded_parameters(dkuk::async_core::context::overflow::redirect);
+	
+	dkuk::async_core::context_tree t;
+	const auto root      = t.add_context(0, 0);
+	const auto primary   = t.add_context(root, 0);
+	const auto secondary = t.add_context(root, 1);
+	parameters.overflow_context_id = secondary;
+	t.set_context_parameters(primary, parameters);
+	dkuk::async_core core{t};
+	core.retire_context(secondary);
+	
+	std::atomic<std::size_t> executed{0};
+	for (std::size_t i = 0; i < capacity; ++i)
+		core.post(primary, [&executed] { ++executed; });
+	
+	if (core.try_post(primary, [&executed] { ++executed; }))
+		throw std::logic_error{"Retired: task is redirected to the retired context"};
+	
+	bool thrown = false;
+	try {
+		core.post(secondary, [&executed] { ++executed; });
+	} catch (const std::invalid_argument &) {
+		thrown = true;
+	}
+	
+	const auto statistics = core.get_context_statistics(primary);
+	if (!thrown || core.try_post(secondary, [&executed] { ++executed; }))
+		throw std::logic_error{"Retired: task is posted to the retired context"};
+	if (statistics.tasks_redirected != 0 || statistics.tasks_rejected != 1 || statistics.queue_size != capacity)
+		throw std::logic_error{"Retired: rejected " + std::to_string(statistics.tasks_rejected) + " tasks"};
+}
+
+
+// Queue longer than one pump's batch is run completely, by several workers, even if some tasks throw.
+void
+check_batches()
+{
+	constexpr std::size_t long_capacity = 1000;
+	
+	auto parameters = bounded_parameters(dkuk::async_core::context::overflow::reject);
+	parameters.capacity = long_capacity;
+	
+	dkuk::async_core::context_tree t;
+	const auto root = t.add_context(0, 0);
+	const auto bounded = t.add_context(root, 0, parameters);
+	dkuk::async_core core{t, false};
+	
+	std::atomic<std::size_t> executed{0};
+	for (std::size_t i = 0; i < long_capacity; ++i)
+		core.post(
+			bounded,
+			[&executed, i]
+			{
+				++executed;
+				if (i % 100 == 0)
+					throw std::runtime_error{"Task failed"};
+			}
+		);
+	if (core.get_context_statistics(bounded).queue_size != long_capacity)
+		throw std::logic_error{"Batches: tasks are not queued"};
+	
+	std::vector<std::thread> workers;
+	for (std::size_t i = 0; i < 4; ++i)
+		workers.emplace_back(
+			[&]
+			{
+				auto &io_context = core.get_io_context(bounded);
+				while (true) {
+					try {
+						io_context.run();
+						return;
+					} catch (const std::runtime_error &) {}
+				}
+			}
+		);
+	for (auto &worker: workers)
+		worker.join();
+	
+	if (executed != long_capacity || core.get_context_statistics(bounded).queue_size != 0)
+		throw std::logic_error{"Batches: executed " + std::to_string(executed.load()) + " tasks"};
+}
+
+
+};	// namespace
+
+
+
+int
+main()
+{
+	int status = 0;
+	
+	for (
+		const auto &check: {
+			check_reject, check_drop_oldest, check_redirect, check_block,
+			check_retired, check_batches
+		}
+	) {
+		try {
+			check();
+		} catch (const std::exception &e) {
+			std::cout << "Error: " << e.what() << '.' << std::endl;
+			status = 1;
+		}
+	}
+	
+	return status;
+}